@@ -0,0 +1,124 @@
+// Counts heap allocations per compiler phase with and without the
+// per-compilation Arena, and times each phase.
+//
+//     g++ -std=c++17 -O2 -pthread arena_bench.cpp -o arena_bench
+//     ./arena_bench [copies] [--huge-pages]
+//
+// The corpus is the Complete-code.cpp sample repeated `copies` times (1,000
+// by default) with a string literal that needs escape decoding in each copy.
+// Every copy adds a main() and globals, and each main is lowered with all the
+// globals of the corpus, so code size grows with the square of `copies`: a few
+// thousand copies already run out of memory.
+// Allocations are counted by replacing the global operator new.
+
+#define KABIR_NO_MAIN
+#include "../Final Code & Report/Complete-code.cpp"
+
+#include <chrono>
+#include <cstdlib>
+
+static size_t heapAllocations = 0;
+
+void *operator new(size_t size) {
+    heapAllocations++;
+    if (void *p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    free(p);
+}
+
+struct Phase {
+    size_t allocations = 0;
+    double seconds = 0;
+};
+
+template <typename Run>
+static Phase measure(Run run) {
+    size_t before = heapAllocations;
+    auto begin = chrono::steady_clock::now();
+    run();
+    Phase phase;
+    phase.seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+    phase.allocations = heapAllocations - before;
+    return phase;
+}
+
+// Runs the phases the way Kabir_ka_Compiler::translate does, one at a time.
+static vector<Phase> runPhases(const string &corpus, Arena *arena) {
+    vector<Phase> phases;
+    Interner interner;
+    Lexer lexer(corpus, interner, arena);
+    ArenaVector<Token> tokens{ArenaAllocator<Token>(arena)};
+    phases.push_back(measure([&] {
+        Token token;
+        while (lexer.next(token)) tokens.push_back(token);
+        tokens.push_back(lexer.endToken());
+    }));
+
+    SymbolTable symbolTable(interner, arena);
+    phases.push_back(measure([&] {
+        for (const Token &token : tokens) symbolTable.observe(token);
+    }));
+
+    IntermediateCodeGenerator generator(interner, arena);
+    // On the same arena as the generated code, so assigning it moves rather
+    // than copies.
+    IntermediateCodeGenerator::Code code{ArenaAllocator<IntermediateCodeGenerator::ThreeAddressCode>(arena)};
+    phases.push_back(measure([&] {
+        struct Replay {
+            const ArenaVector<Token> &tokens;
+            size_t pos;
+            Token nextToken() { return pos < tokens.size() ? tokens[pos++] : tokens.back(); }
+        } replay{tokens, 0};
+        TokenStream<Replay> stream(replay);
+        code = generator.generate(stream);
+    }));
+
+    AssemblyGenerator assembler(interner);
+    phases.push_back(measure([&] {
+        assembler.generate(code);
+    }));
+    return phases;
+}
+
+int main(int argc, char *argv[]) {
+    size_t copies = 1000;
+    bool hugePages = false;
+    for (int i = 1; i < argc; ++i) {
+        if (string(argv[i]) == "--huge-pages") hugePages = true;
+        else copies = strtoull(argv[i], nullptr, 10);
+    }
+
+    string corpus;
+    for (size_t i = 0; i < copies; ++i) {
+        corpus += SAMPLE_PROGRAM;
+        corpus += "string escaped = \"tab\\there\\n\";\n";
+    }
+
+    vector<Phase> heap = runPhases(corpus, nullptr);
+    size_t blocks;
+    vector<Phase> pooled;
+    {
+        Arena arena(hugePages);
+        pooled = runPhases(corpus, &arena);
+        blocks = arena.blockCount();
+    }
+
+    const char *names[] = {"lex", "declaration pass", "intermediate code", "assembly"};
+    cout << corpus.size() / 1e6 << " MB; arena " << (hugePages ? "with" : "without") << " huge pages, " << blocks
+         << " blocks" << endl;
+    cout << left << setw(20) << "phase" << right << setw(14) << "heap allocs" << setw(14) << "arena allocs"
+         << setw(12) << "heap ms" << setw(12) << "arena ms" << endl;
+    for (size_t i = 0; i < heap.size(); ++i) {
+        cout << left << setw(20) << names[i] << right << setw(14) << heap[i].allocations << setw(14)
+             << pooled[i].allocations << fixed << setprecision(1) << setw(12) << heap[i].seconds * 1e3 << setw(12)
+             << pooled[i].seconds * 1e3 << endl;
+    }
+    return 0;
+}
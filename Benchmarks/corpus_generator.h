@@ -0,0 +1,257 @@
+#ifndef BENCHMARKS_CORPUS_GENERATOR_H
+#define BENCHMARKS_CORPUS_GENERATOR_H
+
+// Synthetic lexer input of a given size and shape, built from the sample
+// programs in "Final Code & Report/Complete-code.cpp" and Testing/testing.cpp.
+//
+//     sample        the sample programs themselves, repeated
+//     identifiers   sample statements with every name replaced by a long one
+//                   from a pool of thousands, plus testing.cpp-style
+//                   expressions over them: identifier scanning and interning
+//     literals      declarations initialised with decimal, hex and octal
+//                   integers, floats with exponents and suffixes, and string
+//                   literals, some with escapes
+//     indented      sample statements nested in if/while blocks up to 24
+//                   levels deep, four spaces per level: whitespace skipping
+//     comments      sample statements between // and /* */ comment prose.
+//                   Neither lexer has comment rules, so the prose is lexed
+//                   as ordinary tokens; the shape measures that cost.
+//
+// Generation is deterministic for a given shape, size and seed:
+//
+//     CorpusGenerator generator(SAMPLE_PROGRAM);
+//     string corpus = generator.generate(CorpusGenerator::LITERALS, 16 << 20);
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class CorpusGenerator {
+public:
+    enum Shape { SAMPLE, IDENTIFIERS, LITERALS, INDENTED, COMMENTS, SHAPE_COUNT };
+
+    static const char *shapeName(Shape shape) {
+        static const char *const names[] = {"sample", "identifiers", "literals", "indented", "comments"};
+        return names[shape];
+    }
+
+    // SHAPE_COUNT if `name` is not a shape.
+    static Shape shapeNamed(std::string_view name) {
+        for (int shape = 0; shape < SHAPE_COUNT; ++shape) {
+            if (name == shapeName((Shape)shape)) return (Shape)shape;
+        }
+        return SHAPE_COUNT;
+    }
+
+    // The expression program from Testing/testing.cpp.
+    static constexpr const char *TESTING_PROGRAM = R"(
+
+int a = 10;
+int b = 5;
+int c = 20;
+int result = (a + b) * c / (b - 3) && (a != b) || (c > a && b <= c);
+
+
+    )";
+
+    // `program` is the Complete-code.cpp sample (SAMPLE_PROGRAM).
+    explicit CorpusGenerator(std::string_view program) : program(program) {
+        for (std::string_view text : {program, std::string_view(TESTING_PROGRAM)}) {
+            size_t begin = 0;
+            while (begin < text.size()) {
+                size_t end = text.find('\n', begin);
+                if (end == std::string_view::npos) end = text.size();
+                std::string_view line = trim(text.substr(begin, end - begin));
+                // Whole statements only, so nesting them keeps braces balanced.
+                if (!line.empty() && line.back() == ';') statements.emplace_back(line);
+                begin = end + 1;
+            }
+        }
+    }
+
+    // At least `bytes` bytes of `shape`, ending at a line boundary.
+    std::string generate(Shape shape, size_t bytes, unsigned seed = 18) const {
+        std::mt19937 rng(seed);
+        std::string out;
+        out.reserve(bytes + 4096);
+        for (size_t block = 0; out.size() < bytes; ++block) {
+            switch (shape) {
+                case SAMPLE: out += block % 8 == 7 ? std::string_view(TESTING_PROGRAM) : program; break;
+                case IDENTIFIERS: identifierBlock(out, rng); break;
+                case LITERALS: literalBlock(out, rng); break;
+                case INDENTED: indentedBlock(out, rng); break;
+                case COMMENTS: commentBlock(out, rng); break;
+                default: return out;
+            }
+        }
+        return out;
+    }
+
+private:
+    static const int NAME_POOL = 8192;
+    static const int MAX_DEPTH = 24;
+
+    std::string_view program;
+    std::vector<std::string> statements;
+
+    static std::string_view trim(std::string_view text) {
+        size_t begin = text.find_first_not_of(" \t\r");
+        if (begin == std::string_view::npos) return std::string_view();
+        return text.substr(begin, text.find_last_not_of(" \t\r") - begin + 1);
+    }
+
+    static bool isKeyword(std::string_view word) {
+        static const char *const keywords[] = {
+            "if", "else", "while", "for", "return", "int", "float", "double", "char", "string", "void", "break",
+            "continue", "switch", "case", "default", "public", "private", "protected", "try", "catch", "throw",
+            "struct"};
+        for (const char *keyword : keywords) {
+            if (word == keyword) return true;
+        }
+        return false;
+    }
+
+    static bool isWordChar(char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+    }
+
+    static std::string longName(std::mt19937 &rng) {
+        static const char *const stems[] = {"account", "buffer", "counter", "element", "position", "record",
+                                            "request", "segment", "total", "value", "window", "result"};
+        static const char *const suffixes[] = {"Count", "Index", "Offset", "Limit", "Total", "State"};
+        unsigned id = rng() % NAME_POOL;
+        return std::string(stems[id % 12]) + suffixes[id / 12 % 6] + "_" + std::to_string(id);
+    }
+
+    const std::string &statement(std::mt19937 &rng) const {
+        return statements[rng() % statements.size()];
+    }
+
+    // A statement with each non-keyword word outside string literals renamed.
+    void renamed(std::string &out, std::string_view text, std::mt19937 &rng) const {
+        bool inString = false;
+        for (size_t i = 0; i < text.size();) {
+            char c = text[i];
+            if (c == '"' && (i == 0 || text[i - 1] != '\\')) inString = !inString;
+            if (inString || !isWordChar(c) || (c >= '0' && c <= '9')) {
+                out += c;
+                ++i;
+                continue;
+            }
+            size_t end = i;
+            while (end < text.size() && isWordChar(text[end])) ++end;
+            std::string_view word = text.substr(i, end - i);
+            if (isKeyword(word)) {
+                out += word;
+            } else {
+                out += longName(rng);
+            }
+            i = end;
+        }
+    }
+
+    void identifierBlock(std::string &out, std::mt19937 &rng) const {
+        for (int i = 0; i < 16; ++i) {
+            out += "    ";
+            renamed(out, statement(rng), rng);
+            out += '\n';
+        }
+        // testing.cpp's expression, over long names.
+        out += "    int " + longName(rng) + " = (" + longName(rng) + " + " + longName(rng) + ") * " + longName(rng) +
+               " / (" + longName(rng) + " - 3) && (" + longName(rng) + " != " + longName(rng) + ") || (" +
+               longName(rng) + " > " + longName(rng) + " && " + longName(rng) + " <= " + longName(rng) + ");\n";
+    }
+
+    void literalBlock(std::string &out, std::mt19937 &rng) const {
+        static const char text[] = "abcdefghijklmnopqrstuvwxyz ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789,.:;!?-_()";
+        static const char *const escapes[] = {"\\n", "\\t", "\\\"", "\\\\"};
+        for (int i = 0; i < 16; ++i) {
+            unsigned id = rng() % NAME_POOL;
+            switch (rng() % 7) {
+                case 0: out += "    int n" + std::to_string(id) + " = " + std::to_string(rng()) + ";\n"; break;
+                case 1: out += "    int h" + std::to_string(id) + " = 0x" + hex(rng()) + "u;\n"; break;
+                case 2: out += "    int o" + std::to_string(id) + " = 0" + std::to_string(rng() % 7 + 1) + "7;\n"; break;
+                case 3:
+                    out += "    double d" + std::to_string(id) + " = " + std::to_string(rng() % 100000) + "." +
+                           std::to_string(rng() % 1000) + "e" + (rng() % 2 ? "+" : "-") + std::to_string(rng() % 300) +
+                           ";\n";
+                    break;
+                case 4:
+                    out += "    float f" + std::to_string(id) + " = " + std::to_string(rng() % 1000) + "." +
+                           std::to_string(rng() % 100) + "f;\n";
+                    break;
+                default: {
+                    out += "    string s" + std::to_string(id) + " = \"";
+                    size_t length = 8 + rng() % 72;
+                    bool escaped = rng() % 4 == 0;
+                    for (size_t j = 0; j < length; ++j) {
+                        if (escaped && rng() % 16 == 0) {
+                            out += escapes[rng() % 4];
+                        } else {
+                            out += text[rng() % (sizeof(text) - 1)];
+                        }
+                    }
+                    out += "\";\n";
+                }
+            }
+        }
+    }
+
+    void indentedBlock(std::string &out, std::mt19937 &rng) const {
+        static const char *const openers[] = {"if (a > 0) {", "while (b < 10) {", "if (c != d) {", "for (i) {"};
+        int depth = 1 + (int)(rng() % MAX_DEPTH);
+        for (int level = 0; level < depth; ++level) {
+            out.append(4 * level, ' ');
+            out += openers[rng() % 4];
+            out += '\n';
+            for (int i = rng() % 3; i > 0; --i) {
+                out.append(4 * (level + 1), ' ');
+                out += statement(rng);
+                out += '\n';
+            }
+        }
+        for (int level = depth; level-- > 0;) {
+            out.append(4 * level, ' ');
+            out += "}\n";
+        }
+    }
+
+    void commentBlock(std::string &out, std::mt19937 &rng) const {
+        static const char *const words[] = {"the", "value", "is", "checked", "before", "use", "and", "then",
+                                            "stored", "in", "table", "so", "later", "passes", "can", "skip", "it"};
+        auto prose = [&](size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                out += i ? " " : "";
+                out += words[rng() % 17];
+            }
+        };
+        out += "    /*\n";
+        for (int i = 1 + rng() % 4; i > 0; --i) {
+            out += "     * ";
+            prose(6 + rng() % 8);
+            out += '\n';
+        }
+        out += "     */\n";
+        for (int i = 0; i < 4; ++i) {
+            out += "    // ";
+            prose(4 + rng() % 10);
+            out += "\n    ";
+            out += statement(rng);
+            out += '\n';
+        }
+    }
+
+    static std::string hex(unsigned value) {
+        static const char digits[] = "0123456789ABCDEF";
+        std::string text;
+        do {
+            text.insert(text.begin(), digits[value & 15]);
+            value >>= 4;
+        } while (value);
+        return text;
+    }
+};
+
+#endif
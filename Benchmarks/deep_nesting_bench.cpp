@@ -0,0 +1,193 @@
+// Parser and IntermediateCodeGenerator throughput on pathologically nested
+// input, in both ParseModes.
+//
+//     g++ -std=c++17 -O2 -pthread deep_nesting_bench.cpp -o deep_nesting_bench
+//     ./deep_nesting_bench [depth ...] [--recursive-limit N] [--rounds N]
+//
+// Each shape is one statement nested `depth` times inside main:
+//
+//     blocks        { { { ... x = 1; ... } } }
+//     ifs           if (x) if (x) ... x = 1;
+//     parentheses   x = ((( ... 1 ... )));
+//     unary         x = - ! - ! ... 1;
+//     calls         x = f(f(f( ... 1 ... )));
+//     assignments   x = x = x = ... 1;   (right-associative)
+//     unclosed      { if (x) { if (x) ... x = (1 with nothing closed: one
+//                   error, then every open level gives up at the end of input
+//
+// Depths default to 1,000, 10,000, 100,000 and 1,000,000. EXPLICIT_STACK
+// runs at every depth. RECURSIVE_DESCENT only runs up to --recursive-limit
+// (default 10,000), as deeper input overflows the native stack; where both
+// run, their trees, error lists and code must be identical or the bench
+// fails. Tokens are lexed once up front. Each tree is then lowered by a
+// generator in the same mode, so a deep input is taken through the whole
+// compilation short of assembly; "parse ms" and "lower ms" are the two
+// phases, each the best of --rounds runs (default 3). As in the compiler, a
+// tree with errors is not lowered: "unclosed" has no "lower ms".
+
+#define KABIR_NO_MAIN
+#include "../Final Code & Report/Complete-code.cpp"
+
+#include <chrono>
+#include <functional>
+
+// Replays lexed tokens, then END_OF_FILE for good.
+class ReplayTokens {
+public:
+    explicit ReplayTokens(const vector<Token> &tokens) : tokens(tokens) {}
+
+    Token nextToken() {
+        return pos < tokens.size() ? tokens[pos++] : tokens.back();
+    }
+
+private:
+    const vector<Token> &tokens;
+    size_t pos = 0;
+};
+
+struct Shape {
+    const char *name;
+    function<string(size_t)> generate;
+};
+
+static string repeat(const char *text, size_t count) {
+    string out;
+    out.reserve(strlen(text) * count);
+    for (size_t i = 0; i < count; ++i) out += text;
+    return out;
+}
+
+static vector<Shape> shapes() {
+    return {
+        {"blocks", [](size_t n) { return "int main() {\n" + repeat("{\n", n) + "x = 1;\n" + repeat("}\n", n) + "}\n"; }},
+        {"ifs", [](size_t n) { return "int main() {\n" + repeat("if (x) ", n) + "x = 1;\n}\n"; }},
+        {"parentheses", [](size_t n) { return "int main() {\nx = " + repeat("(", n) + "1" + repeat(")", n) + ";\n}\n"; }},
+        {"unary", [](size_t n) { return "int main() {\nx = " + repeat("- ! ", n / 2) + "1;\n}\n"; }},
+        {"calls", [](size_t n) { return "int main() {\nx = " + repeat("f(", n) + "1" + repeat(")", n) + ";\n}\n"; }},
+        {"assignments", [](size_t n) { return "int main() {\n" + repeat("x = ", n) + "1;\n}\n"; }},
+        {"unclosed", [](size_t n) { return "int main() {\n" + repeat("{ if (x) ", n / 2) + "x = (1"; }},
+    };
+}
+
+struct ParseResult {
+    SyntaxTree tree;
+    vector<SyntaxError> errors;
+    double seconds;
+    string code;  // The tree lowered in the same mode, as text
+    double lowerSeconds;
+};
+
+static ParseResult parse(const vector<Token> &tokens, Interner &interner, ParseMode mode, int rounds) {
+    ParseResult result{SyntaxTree(), {}, 1e30, string(), 1e30};
+    for (int round = 0; round < rounds; ++round) {
+        ReplayTokens replay(tokens);
+        TokenStream<ReplayTokens> stream(replay);
+        Parser<TokenStream<ReplayTokens>> parser(stream, interner, nullptr, mode);
+        auto begin = chrono::steady_clock::now();
+        SyntaxTree tree = parser.parse();
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+        if (seconds < result.seconds) {
+            result.tree = move(tree);
+            result.errors = parser.errors();
+            result.seconds = seconds;
+        }
+    }
+    for (int round = 0; round < rounds && result.errors.empty(); ++round) {
+        IntermediateCodeGenerator generator(interner, nullptr, mode);
+        auto begin = chrono::steady_clock::now();
+        IntermediateCodeGenerator::Code code = generator.generate(result.tree);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+        if (seconds < result.lowerSeconds) result.lowerSeconds = seconds;
+        if (round == 0) {
+            ostringstream text;
+            for (const auto &instruction : code) {
+                instruction.format(text, interner);
+                text << '\n';
+            }
+            result.code = text.str();
+        }
+    }
+    return result;
+}
+
+// Walks both trees side by side, with a stack rather than by recursion.
+static bool sameTree(const SyntaxTree &a, const SyntaxTree &b) {
+    vector<pair<uint32_t, uint32_t>> pending{{a.root, b.root}};
+    while (!pending.empty()) {
+        auto [i, j] = pending.back();
+        pending.pop_back();
+        if ((i == SyntaxNode::NONE) != (j == SyntaxNode::NONE)) return false;
+        if (i == SyntaxNode::NONE) continue;
+        const SyntaxNode &x = a[i], &y = b[j];
+        if (x.kind != y.kind || x.op != y.op || x.flags != y.flags || x.line != y.line || x.integer != y.integer) {
+            return false;
+        }
+        pending.push_back({x.next, y.next});
+        for (int c = 0; c < 3; ++c) pending.push_back({x.child[c], y.child[c]});
+    }
+    return true;
+}
+
+static bool sameErrors(const vector<SyntaxError> &a, const vector<SyntaxError> &b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].line != b[i].line || a[i].column != b[i].column || a[i].message != b[i].message) return false;
+    }
+    return true;
+}
+
+static void report(const char *shape, size_t depth, const char *mode, size_t tokens, const ParseResult &result) {
+    cout << left << setw(13) << shape << right << setw(9) << depth << "  " << left << setw(19) << mode << right
+         << fixed << setprecision(2) << setw(10) << result.seconds * 1e3 << setw(11)
+         << tokens / result.seconds / 1e6 << setw(9) << result.errors.size() << setw(10);
+    if (result.errors.empty()) {
+        cout << result.lowerSeconds * 1e3 << endl;
+    } else {
+        cout << "-" << endl;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    vector<size_t> depths;
+    size_t recursiveLimit = 10000;
+    int rounds = 3;
+    for (int arg = 1; arg < argc; ++arg) {
+        string option = argv[arg];
+        if (option == "--recursive-limit" && arg + 1 < argc) {
+            recursiveLimit = strtoull(argv[++arg], nullptr, 10);
+        } else if (option == "--rounds" && arg + 1 < argc) {
+            rounds = max(1, atoi(argv[++arg]));
+        } else if (isdigit((unsigned char)option[0])) {
+            depths.push_back(strtoull(option.c_str(), nullptr, 10));
+        } else {
+            cerr << "unknown argument " << option << endl;
+            return 2;
+        }
+    }
+    if (depths.empty()) depths = {1000, 10000, 100000, 1000000};
+
+    cout << left << setw(13) << "shape" << right << setw(9) << "depth" << "  " << left << setw(19) << "mode" << right
+         << setw(10) << "parse ms" << setw(11) << "Mtokens/s" << setw(9) << "errors" << setw(10) << "lower ms"
+         << endl;
+    for (const Shape &shape : shapes()) {
+        for (size_t depth : depths) {
+            string source = shape.generate(depth);
+            Interner interner;
+            Lexer lexer(source, interner);
+            vector<Token> tokens = lexer.tokenize();
+
+            ParseResult stack = parse(tokens, interner, EXPLICIT_STACK, rounds);
+            report(shape.name, depth, "explicit stack", tokens.size(), stack);
+            if (depth > recursiveLimit) continue;
+
+            ParseResult recursive = parse(tokens, interner, RECURSIVE_DESCENT, rounds);
+            report(shape.name, depth, "recursive descent", tokens.size(), recursive);
+            if (!sameTree(stack.tree, recursive.tree) || !sameErrors(stack.errors, recursive.errors) ||
+                stack.code != recursive.code) {
+                cerr << shape.name << " at depth " << depth << ": the two modes disagree" << endl;
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,121 @@
+// Checks that DfaLexer (tables generated from tokens.l) matches
+// Lexer::tokenize token for token, then compares their throughput.
+//
+//     g++ -std=c++17 -O2 dfa_lexer_bench.cpp -o dfa_lexer_bench
+//     ./dfa_lexer_bench [megabytes]
+//
+// Correctness runs on the Complete-code.cpp sample, week4/code.txt and
+// random byte soup; throughput runs on the sample repeated to the requested
+// size, best of three. Neither lexer collects symbols; that is a separate
+// pass over the tokens (see declaration_pass_bench.cpp).
+//
+// Both are timed through tokenize(), Token vector included. Writing that
+// vector is most of the cost of either lexer; DfaLexer sizes it up front
+// while Lexer lets it grow. The "DFA scan" row walks the tables alone,
+// finding token boundaries without building tokens, to show what the inner
+// loop itself costs.
+
+#define KABIR_NO_MAIN
+#include "../Final Code & Report/Complete-code.cpp"
+
+#include <chrono>
+#include <fstream>
+#include <random>
+
+static bool sameTokens(const vector<Token> &expected, const vector<Token> &actual, const string &name) {
+    size_t n = min(expected.size(), actual.size());
+    for (size_t i = 0; i < n; ++i) {
+        const Token &a = expected[i], &b = actual[i];
+        if (a.type != b.type || a.symbol != b.symbol || a.value != b.value || a.line != b.line || a.column != b.column ||
+            a.offset != b.offset || a.length != b.length || a.number.integer != b.number.integer) {
+            cerr << name << ": token " << i << " differs\n  Lexer:    " << a.toString()
+                 << "\n  DfaLexer: " << b.toString() << endl;
+            return false;
+        }
+    }
+    if (expected.size() != actual.size()) {
+        cerr << name << ": " << expected.size() << " tokens vs " << actual.size() << endl;
+        return false;
+    }
+    return true;
+}
+
+static bool check(const string &source, const string &name) {
+    Interner lexerNames, dfaNames;
+    Lexer lexer(source, lexerNames);
+    DfaLexer dfaLexer(source, dfaNames);
+    return sameTokens(lexer.tokenize(), dfaLexer.tokenize(), name);
+}
+
+template <typename Tokenize>
+static void time(const char *name, const string &source, Tokenize tokenize) {
+    double seconds = 1e30;
+    size_t count = 0;
+    for (int run = 0; run < 3; ++run) {
+        auto begin = chrono::steady_clock::now();
+        count = tokenize(source);
+        seconds = min(seconds, chrono::duration<double>(chrono::steady_clock::now() - begin).count());
+    }
+    cout << setw(10) << name << fixed << setprecision(1) << setw(10) << source.size() / seconds / 1e6
+         << " MB/s" << setw(10) << count / seconds / 1e6 << " Mtokens/s" << endl;
+}
+
+// DfaLexer's loop without the tokens: counts the lexemes it would match.
+static size_t scanTokens(const string &source) {
+    const char *p = source.data(), *end = p + source.size();
+    size_t count = 0;
+    while (true) {
+        size_t newlines = 0;
+        const char *lastNewline = nullptr;
+        p = simd::skipWhitespace(p, end, newlines, lastNewline);
+        if (p >= end) return count;
+        const char *acceptEnd = p;
+        uint32_t state = DFA_START;
+        while (p < end) {
+            state = dfaTransitions[state + dfaCharClass[(unsigned char)*p]];
+            if (state == 0) break;
+            ++p;
+            if (state >= DFA_FIRST_ACCEPTING) acceptEnd = p;
+        }
+        p = acceptEnd;
+        count++;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    size_t megabytes = argc > 1 ? strtoull(argv[1], nullptr, 10) : 32;
+
+    bool ok = check(SAMPLE_PROGRAM, "sample");
+    ifstream codeFile("../week4/code.txt");
+    if (codeFile) {
+        stringstream buffer;
+        buffer << codeFile.rdbuf();
+        ok &= check(buffer.str(), "week4/code.txt");
+    }
+
+    const char alphabet[] = "  \n\tabz_Z0178.xeEfFlLuU\"\\\\+-*/%=<>!&|(){};,':#\x80\xff";
+    mt19937 rng(7);
+    for (int i = 0; i < 20000 && ok; ++i) {
+        string soup(rng() % 64, ' ');
+        for (char &c : soup) c = alphabet[rng() % (sizeof(alphabet) - 1)];
+        ok &= check(soup, "random input " + to_string(i));
+    }
+    if (!ok) return 1;
+    cout << "Token streams match" << endl;
+
+    string corpus;
+    while (corpus.size() < megabytes << 20) corpus += SAMPLE_PROGRAM;
+    cout << "Lexing " << corpus.size() / 1e6 << " MB" << endl;
+    time("Lexer", corpus, [](const string &s) {
+        Interner interner;
+        Lexer lexer(s, interner);
+        return lexer.tokenize().size();
+    });
+    time("DfaLexer", corpus, [](const string &s) {
+        Interner interner;
+        DfaLexer lexer(s, interner);
+        return lexer.tokenize().size();
+    });
+    time("DFA scan", corpus, [](const string &s) { return scanTokens(s); });
+    return 0;
+}
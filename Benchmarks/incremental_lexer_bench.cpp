@@ -0,0 +1,97 @@
+// Checks IncrementalLexer against a full Lexer::tokenize after every edit,
+// and that it holds no more decoded literals than a fresh lex of the text,
+// then times single-keystroke edits against relexing the whole buffer.
+//
+//     g++ -std=c++17 -O2 -pthread incremental_lexer_bench.cpp -o incremental_lexer_bench
+//     ./incremental_lexer_bench [megabytes]
+//
+// The random edits insert and delete runs of code, quotes, backslashes,
+// comment delimiters and newlines anywhere in the buffer, so literals and
+// comments open and close across large spans and the resync point moves around; the timed edits type a statement
+// one character at a time in the middle of a large file.
+
+#define KABIR_NO_MAIN
+#include "../Final Code & Report/Complete-code.cpp"
+
+#include <chrono>
+#include <random>
+
+static bool sameTokens(const vector<Token> &expected, const vector<Token> &actual, const string &name) {
+    size_t n = min(expected.size(), actual.size());
+    for (size_t i = 0; i < n; ++i) {
+        const Token &a = expected[i], &b = actual[i];
+        if (a.type != b.type || a.symbol != b.symbol || a.value != b.value || a.line != b.line || a.column != b.column ||
+            a.offset != b.offset || a.length != b.length || a.number.integer != b.number.integer) {
+            cerr << name << ": token " << i << " differs\n  Lexer:            " << a.toString()
+                 << "\n  IncrementalLexer: " << b.toString() << endl;
+            return false;
+        }
+    }
+    if (expected.size() != actual.size()) {
+        cerr << name << ": " << expected.size() << " tokens vs " << actual.size() << endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    size_t megabytes = argc > 1 ? strtoull(argv[1], nullptr, 10) : 16;
+
+    // One interner for both sides, so identifier ids are comparable.
+    Interner interner;
+    const char *snippets[] = {"\"", "\\", "\n", " ", "x", "=", "==", "12", ".5", "int y = 3;\n", "\"a\\\"b\"", "|", "&&",
+                              "if (a) { b = \"c\n\"; }", "/*", "*/", "//", "'", "'a'"};
+    mt19937 rng(5);
+    bool ok = true;
+    for (int round = 0; round < 200 && ok; ++round) {
+        IncrementalLexer incremental(interner);
+        incremental.reset(SAMPLE_PROGRAM);
+        for (int step = 0; step < 100 && ok; ++step) {
+            string_view text = incremental.text();
+            size_t offset = rng() % (text.size() + 1);
+            size_t removed = rng() % 3 == 0 ? rng() % min<size_t>(text.size() - offset + 1, 40) : 0;
+            string inserted = rng() % 4 == 0 ? "" : snippets[rng() % size(snippets)];
+            incremental.applyEdit({offset, removed, inserted});
+
+            string copy(incremental.text());
+            Lexer lexer(copy, interner);
+            ok = sameTokens(lexer.tokenize(), incremental.allTokens(),
+                            "round " + to_string(round) + " step " + to_string(step));
+
+            // Literals of replaced tokens must have been freed.
+            IncrementalLexer fresh(interner);
+            fresh.reset(copy);
+            if (ok && fresh.literalCount() != incremental.literalCount()) {
+                cerr << "round " << round << " step " << step << ": " << incremental.literalCount()
+                     << " decoded literals held, " << fresh.literalCount() << " in use" << endl;
+                ok = false;
+            }
+        }
+    }
+    if (!ok) return 1;
+    cout << "Token streams match" << endl;
+
+    string corpus;
+    while (corpus.size() < megabytes << 20) corpus += SAMPLE_PROGRAM;
+    IncrementalLexer incremental(interner);
+    incremental.reset(corpus);
+
+    auto begin = chrono::steady_clock::now();
+    Lexer full(corpus, interner);
+    size_t count = full.tokenize().size();
+    double fullSeconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+
+    const string typed = "int total = a + b * 2;\n";
+    size_t offset = corpus.size() / 2;
+    offset = corpus.find('\n', offset) + 1;
+    begin = chrono::steady_clock::now();
+    for (char c : typed) {
+        incremental.applyEdit({offset++, 0, string_view(&c, 1)});
+    }
+    double editSeconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count() / typed.size();
+
+    cout << fixed << setprecision(3) << corpus.size() / 1e6 << " MB, " << count << " tokens\n"
+         << "  full relex      " << setw(10) << fullSeconds * 1e3 << " ms\n"
+         << "  one keystroke   " << setw(10) << editSeconds * 1e3 << " ms" << endl;
+    return 0;
+}
@@ -0,0 +1,134 @@
+// Keyword recognition microbenchmark.
+//
+// Classifies an identifier-heavy word stream three ways: the unordered_map
+// that Complete-code.cpp used, the if/else chain of string compares that the
+// Week9/Week7/TAC lexers used, and the perfect-hash KeywordTable that all of
+// them use now. Words come from the Complete-code.cpp sample program, roughly
+// one keyword per three identifiers.
+//
+//     g++ -std=c++17 -O2 keyword_bench.cpp -o keyword_bench
+//     ./keyword_bench [words]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <iterator>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "../common/keyword_table.h"
+
+using namespace std;
+
+enum TokenType {
+    IF, ELSE, WHILE, FOR, RETURN, INT, FLOAT, DOUBLE, CHAR, STRING, VOID, BREAK, CONTINUE,
+    SWITCH, CASE, DEFAULT, PUBLIC, PRIVATE, PROTECTED, TRY, CATCH, THROW, STRUCT, IDENTIFIER
+};
+
+static TokenType lookupMap(const string &word) {
+    static const unordered_map<string, TokenType> keywords = {
+        {"if", IF}, {"else", ELSE},   {"while", WHILE}, {"for", FOR}, {"return", RETURN},
+        {"int", INT}, {"float", FLOAT}, {"double", DOUBLE},
+        {"char", CHAR}, {"string", STRING}, {"void", VOID},
+        {"break", BREAK}, {"continue", CONTINUE}, {"switch", SWITCH},
+        {"case", CASE}, {"default", DEFAULT}, {"public", PUBLIC},
+        {"private", PRIVATE}, {"protected", PROTECTED}, {"try", TRY},
+        {"catch", CATCH}, {"throw", THROW}, {"struct", STRUCT}
+    };
+    auto it = keywords.find(word);
+    return it != keywords.end() ? it->second : IDENTIFIER;
+}
+
+static TokenType lookupChain(const string &word) {
+    if (word == "if") return IF;
+    else if (word == "else") return ELSE;
+    else if (word == "while") return WHILE;
+    else if (word == "for") return FOR;
+    else if (word == "return") return RETURN;
+    else if (word == "int") return INT;
+    else if (word == "float") return FLOAT;
+    else if (word == "double") return DOUBLE;
+    else if (word == "char") return CHAR;
+    else if (word == "string") return STRING;
+    else if (word == "void") return VOID;
+    else if (word == "break") return BREAK;
+    else if (word == "continue") return CONTINUE;
+    else if (word == "switch") return SWITCH;
+    else if (word == "case") return CASE;
+    else if (word == "default") return DEFAULT;
+    else if (word == "public") return PUBLIC;
+    else if (word == "private") return PRIVATE;
+    else if (word == "protected") return PROTECTED;
+    else if (word == "try") return TRY;
+    else if (word == "catch") return CATCH;
+    else if (word == "throw") return THROW;
+    else if (word == "struct") return STRUCT;
+    return IDENTIFIER;
+}
+
+static TokenType lookupPerfectHash(string_view word) {
+    static constexpr auto keywords = makeKeywordTable<TokenType>({
+        {"if", IF}, {"else", ELSE},   {"while", WHILE}, {"for", FOR}, {"return", RETURN},
+        {"int", INT}, {"float", FLOAT}, {"double", DOUBLE},
+        {"char", CHAR}, {"string", STRING}, {"void", VOID},
+        {"break", BREAK}, {"continue", CONTINUE}, {"switch", SWITCH},
+        {"case", CASE}, {"default", DEFAULT}, {"public", PUBLIC},
+        {"private", PRIVATE}, {"protected", PROTECTED}, {"try", TRY},
+        {"catch", CATCH}, {"throw", THROW}, {"struct", STRUCT}
+    });
+    return keywords.find(word, IDENTIFIER);
+}
+
+// Words are stored back to back in one buffer, like identifiers in a source
+// file; the map and chain variants get a std::string per word, as the old
+// lexers built one.
+struct Corpus {
+    string text;
+    vector<pair<uint32_t, uint32_t>> words;
+};
+
+static Corpus makeCorpus(size_t count) {
+    static const char *keywords[] = {"int", "float", "double", "char", "string", "if", "else", "while",
+                                     "for", "return", "switch", "case", "break", "continue", "try",
+                                     "catch", "throw", "struct", "void", "default"};
+    static const char *identifiers[] = {"a", "b", "c", "d", "str", "sum", "diff", "product", "quotient",
+                                        "remainder", "cout", "endl", "i", "msg", "ptr", "MyStruct", "value",
+                                        "obj", "testFunction", "main", "v", "result", "counter_1", "tmp"};
+    mt19937 rng(42);
+    Corpus corpus;
+    for (size_t i = 0; i < count; ++i) {
+        const char *word = rng() % 4 == 0 ? keywords[rng() % size(keywords)] : identifiers[rng() % size(identifiers)];
+        uint32_t offset = (uint32_t)corpus.text.size();
+        corpus.text += word;
+        corpus.words.push_back({offset, (uint32_t)(corpus.text.size() - offset)});
+    }
+    return corpus;
+}
+
+template <typename Lookup>
+static void run(const char *name, const Corpus &corpus, Lookup lookup) {
+    size_t keywordCount = 0;
+    auto begin = chrono::steady_clock::now();
+    for (const auto &word : corpus.words) {
+        keywordCount += lookup(string_view(corpus.text).substr(word.first, word.second)) != IDENTIFIER;
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+    cout << left << setw(14) << name << right << fixed << setprecision(1)
+         << setw(10) << corpus.words.size() / seconds / 1e6 << " Mwords/s"
+         << setw(10) << corpus.text.size() / seconds / 1e6 << " MB/s"
+         << "   (" << keywordCount << " keywords)\n";
+}
+
+int main(int argc, char *argv[]) {
+    size_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+    Corpus corpus = makeCorpus(count);
+    cout << "Keyword lookup over " << count << " words (" << corpus.text.size() / 1e6 << " MB)\n";
+
+    run("unordered_map", corpus, [](string_view w) { return lookupMap(string(w)); });
+    run("if/else chain", corpus, [](string_view w) { return lookupChain(string(w)); });
+    run("perfect hash", corpus, lookupPerfectHash);
+    return 0;
+}
@@ -0,0 +1,273 @@
+// Throughput of every lexer in Complete-code.cpp on each corpus shape from
+// corpus_generator.h, in MB/s and tokens/s, for gating lexer changes.
+//
+//     g++ -std=c++17 -O2 -pthread lexer_suite_bench.cpp -o lexer_suite_bench
+//     ./lexer_suite_bench [megabytes] [shape ...] [--rounds N]
+//                         [--save results.txt] [--baseline results.txt [--tolerance percent]]
+//     ./lexer_suite_bench --corpus shape [megabytes] > corpus.txt
+//
+// Shapes default to all of them, at 16 MB each. Before timing, each lexer's
+// tokens are checked against Lexer::tokenize on the same corpus. Each time is
+// the best of --rounds runs (default 3), with a fresh Interner per run.
+//
+// --save writes one "shape lexer MB/s tokens/s" line per result. --baseline
+// reads such a file and exits with status 1 if any lexer is slower than its
+// baseline by more than --tolerance percent (default 10). --corpus writes a
+// generated corpus, e.g. to feed Complete-code itself.
+//
+// Lexers: Lexer pulled with next() (no token vector), Lexer::tokenize,
+// DfaLexer, ParallelLexer (hardware threads, at least 2), a full relex through
+// IncrementalLexer::reset, and loading the same tokens from a token cache.
+
+#define KABIR_NO_MAIN
+#include "../Final Code & Report/Complete-code.cpp"
+
+#include "corpus_generator.h"
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <thread>
+
+// `check` compares a lexer's tokens with the expected ones while the lexer,
+// which owns any decoded literal values, is still alive.
+struct LexerVariant {
+    const char *name;
+    function<bool(const string &, const vector<Token> &, const string &)> check;
+    function<size_t(const string &, Interner &)> run;  // Timed; returns the token count
+};
+
+struct Result {
+    string shape, lexer;
+    double megabytesPerSecond, tokensPerSecond;
+};
+
+static const string CACHE_DIRECTORY = "lexer_suite_bench.cache";
+
+static bool sameTokens(const vector<Token> &expected, const vector<Token> &actual, const string &name) {
+    size_t n = min(expected.size(), actual.size());
+    for (size_t i = 0; i < n; ++i) {
+        const Token &a = expected[i], &b = actual[i];
+        if (a.type != b.type || a.value != b.value || a.line != b.line || a.column != b.column ||
+            a.offset != b.offset || a.length != b.length || a.number.integer != b.number.integer) {
+            cerr << name << ": token " << i << " differs\n  Lexer: " << a.toString() << "\n  " << name << ": "
+                 << b.toString() << endl;
+            return false;
+        }
+    }
+    if (expected.size() != actual.size()) {
+        cerr << name << ": " << expected.size() << " tokens vs " << actual.size() << endl;
+        return false;
+    }
+    return true;
+}
+
+static vector<LexerVariant> variants() {
+    size_t threads = max(2u, thread::hardware_concurrency());
+    return {
+        {"Lexer::next",
+         [](const string &source, const vector<Token> &expected, const string &name) {
+             Interner interner;
+             Lexer lexer(source, interner);
+             vector<Token> tokens;
+             Token token;
+             while (lexer.next(token)) tokens.push_back(token);
+             tokens.push_back(lexer.endToken());
+             return sameTokens(expected, tokens, name);
+         },
+         [](const string &source, Interner &interner) {
+             Lexer lexer(source, interner);
+             Token token;
+             size_t count = 0;
+             while (lexer.next(token)) count++;
+             return count + 1;
+         }},
+        {"Lexer::tokenize",
+         [](const string &source, const vector<Token> &expected, const string &name) {
+             Interner interner;
+             Lexer lexer(source, interner);
+             return sameTokens(expected, lexer.tokenize(), name);
+         },
+         [](const string &source, Interner &interner) { return Lexer(source, interner).tokenize().size(); }},
+        {"DfaLexer",
+         [](const string &source, const vector<Token> &expected, const string &name) {
+             Interner interner;
+             DfaLexer lexer(source, interner);
+             return sameTokens(expected, lexer.tokenize(), name);
+         },
+         [](const string &source, Interner &interner) { return DfaLexer(source, interner).tokenize().size(); }},
+        {"ParallelLexer",
+         [threads](const string &source, const vector<Token> &expected, const string &name) {
+             Interner interner;
+             ParallelLexer lexer(source, interner, threads);
+             return sameTokens(expected, lexer.tokenize(), name);
+         },
+         [threads](const string &source, Interner &interner) {
+             return ParallelLexer(source, interner, threads).tokenize().size();
+         }},
+        {"IncrementalLexer",
+         [](const string &source, const vector<Token> &expected, const string &name) {
+             Interner interner;
+             IncrementalLexer lexer(interner);
+             lexer.reset(source);
+             return sameTokens(expected, lexer.allTokens(), name);
+         },
+         [](const string &source, Interner &interner) {
+             IncrementalLexer lexer(interner);
+             lexer.reset(source);
+             return lexer.size();
+         }},
+        {"token cache load",
+         [](const string &source, const vector<Token> &expected, const string &name) {
+             Interner interner;
+             TokenCacheFile cache;
+             if (!cache.open(tokenCachePath(CACHE_DIRECTORY, source), source)) return false;
+             CachedTokens tokens(cache, source, interner);
+             return sameTokens(expected, tokens.tokenize(), name);
+         },
+         [](const string &source, Interner &interner) {
+             TokenCacheFile cache;
+             cache.open(tokenCachePath(CACHE_DIRECTORY, source), source);
+             CachedTokens tokens(cache, source, interner);
+             size_t count = 1;
+             while (tokens.nextToken().type != END_OF_FILE) count++;
+             return count;
+         }},
+    };
+}
+
+// Writes the token cache the "token cache load" variant reads.
+static bool prepareCache(const string &source) {
+    Interner interner;
+    Lexer lexer(source, interner);
+    TokenCacheRecorder<Lexer> recorder(lexer, source, interner);
+    while (recorder.nextToken().type != END_OF_FILE) {}
+    return recorder.write(tokenCachePath(CACHE_DIRECTORY, source));
+}
+
+static map<pair<string, string>, double> readBaseline(const string &path) {
+    map<pair<string, string>, double> baseline;
+    ifstream in(path);
+    string line;
+    while (getline(in, line)) {
+        // The lexer name may contain spaces; the two numbers are last.
+        istringstream fields(line);
+        vector<string> words;
+        for (string word; fields >> word;) words.push_back(word);
+        if (words.size() < 4) continue;
+        string lexer = words[1];
+        for (size_t i = 2; i + 2 < words.size(); ++i) lexer += " " + words[i];
+        baseline[{words[0], lexer}] = atof(words[words.size() - 2].c_str());
+    }
+    return baseline;
+}
+
+int main(int argc, char *argv[]) {
+    size_t megabytes = 16;
+    int rounds = 3;
+    double tolerance = 10;
+    string savePath, baselinePath, corpusShape;
+    vector<CorpusGenerator::Shape> shapes;
+    for (int arg = 1; arg < argc; ++arg) {
+        string option = argv[arg];
+        if (option == "--rounds" && arg + 1 < argc) {
+            rounds = max(1, atoi(argv[++arg]));
+        } else if (option == "--save" && arg + 1 < argc) {
+            savePath = argv[++arg];
+        } else if (option == "--baseline" && arg + 1 < argc) {
+            baselinePath = argv[++arg];
+        } else if (option == "--tolerance" && arg + 1 < argc) {
+            tolerance = atof(argv[++arg]);
+        } else if (option == "--corpus" && arg + 1 < argc) {
+            corpusShape = argv[++arg];
+        } else if (isdigit((unsigned char)option[0])) {
+            megabytes = strtoull(option.c_str(), nullptr, 10);
+        } else if (CorpusGenerator::shapeNamed(option) != CorpusGenerator::SHAPE_COUNT) {
+            shapes.push_back(CorpusGenerator::shapeNamed(option));
+        } else {
+            cerr << "unknown argument " << option << endl;
+            return 2;
+        }
+    }
+
+    CorpusGenerator generator(SAMPLE_PROGRAM);
+    if (!corpusShape.empty()) {
+        CorpusGenerator::Shape shape = CorpusGenerator::shapeNamed(corpusShape);
+        if (shape == CorpusGenerator::SHAPE_COUNT) {
+            cerr << "unknown shape " << corpusShape << endl;
+            return 2;
+        }
+        cout << generator.generate(shape, megabytes << 20);
+        return 0;
+    }
+    if (shapes.empty()) {
+        for (int shape = 0; shape < CorpusGenerator::SHAPE_COUNT; ++shape) {
+            shapes.push_back((CorpusGenerator::Shape)shape);
+        }
+    }
+
+    vector<LexerVariant> lexers = variants();
+    vector<Result> results;
+    cout << left << setw(13) << "shape" << setw(18) << "lexer" << right << setw(10) << "MB/s" << setw(13)
+         << "Mtokens/s" << endl;
+    for (CorpusGenerator::Shape shape : shapes) {
+        string corpus = generator.generate(shape, megabytes << 20);
+        if (!prepareCache(corpus)) {
+            cerr << "could not write the token cache in " << CACHE_DIRECTORY << endl;
+            return 1;
+        }
+
+        Interner reference;
+        Lexer referenceLexer(corpus, reference);
+        vector<Token> expected = referenceLexer.tokenize();
+        for (const LexerVariant &lexer : lexers) {
+            if (!lexer.check(corpus, expected, string(CorpusGenerator::shapeName(shape)) + " " + lexer.name)) {
+                return 1;
+            }
+        }
+
+        for (const LexerVariant &lexer : lexers) {
+            double best = 1e30;
+            size_t count = 0;
+            for (int round = 0; round < rounds; ++round) {
+                Interner interner;
+                auto begin = chrono::steady_clock::now();
+                count = lexer.run(corpus, interner);
+                best = min(best, chrono::duration<double>(chrono::steady_clock::now() - begin).count());
+            }
+            Result result{CorpusGenerator::shapeName(shape), lexer.name, corpus.size() / best / 1e6, count / best};
+            results.push_back(result);
+            cout << left << setw(13) << result.shape << setw(18) << result.lexer << right << fixed
+                 << setprecision(1) << setw(10) << result.megabytesPerSecond << setprecision(2) << setw(13)
+                 << result.tokensPerSecond / 1e6 << endl;
+        }
+    }
+    filesystem::remove_all(CACHE_DIRECTORY);
+
+    if (!savePath.empty()) {
+        ofstream out(savePath);
+        for (const Result &result : results) {
+            out << result.shape << ' ' << result.lexer << ' ' << fixed << setprecision(1)
+                << result.megabytesPerSecond << ' ' << setprecision(0) << result.tokensPerSecond << '\n';
+        }
+    }
+
+    if (!baselinePath.empty()) {
+        map<pair<string, string>, double> baseline = readBaseline(baselinePath);
+        bool regressed = false;
+        for (const Result &result : results) {
+            auto it = baseline.find({result.shape, result.lexer});
+            if (it == baseline.end()) continue;
+            double change = (result.megabytesPerSecond / it->second - 1) * 100;
+            if (change < -tolerance) {
+                cout << "REGRESSION " << result.shape << ' ' << result.lexer << ": " << fixed << setprecision(1)
+                     << it->second << " -> " << result.megabytesPerSecond << " MB/s (" << change << "%)" << endl;
+                regressed = true;
+            }
+        }
+        if (regressed) return 1;
+        cout << "No lexer more than " << tolerance << "% slower than " << baselinePath << endl;
+    }
+    return 0;
+}
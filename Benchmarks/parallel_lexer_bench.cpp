@@ -0,0 +1,88 @@
+// Checks that ParallelLexer matches Lexer::tokenize (tokens and ids), then
+// times it at increasing thread counts.
+//
+//     g++ -std=c++17 -O2 -pthread parallel_lexer_bench.cpp -o parallel_lexer_bench
+//     ./parallel_lexer_bench [megabytes]
+//
+// The correctness runs use chunks of a few bytes so that string literals and
+// block comments, including multi-line and unterminated ones, keep landing
+// across cuts and the stitch step has to relex. Throughput runs use the default chunk size
+// on the sample repeated to the requested size, with a multi-line string
+// literal mixed in every so often. A speedup is only printed for thread
+// counts the machine has cores for (std::thread::hardware_concurrency());
+// beyond that the threads share cores and the ratio is noise.
+
+#define KABIR_NO_MAIN
+#include "../Final Code & Report/Complete-code.cpp"
+
+#include <chrono>
+#include <random>
+
+static bool check(const string &source, size_t threads, size_t chunkBytes, const string &name) {
+    Interner serialNames, parallelNames;
+    Lexer lexer(source, serialNames);
+    ParallelLexer parallelLexer(source, parallelNames, threads, chunkBytes);
+    vector<Token> expected = lexer.tokenize();
+    vector<Token> actual = parallelLexer.tokenize();
+
+    size_t n = min(expected.size(), actual.size());
+    for (size_t i = 0; i < n; ++i) {
+        const Token &a = expected[i], &b = actual[i];
+        if (a.type != b.type || a.symbol != b.symbol || a.value != b.value || a.line != b.line || a.column != b.column ||
+            a.offset != b.offset || a.length != b.length || a.number.integer != b.number.integer) {
+            cerr << name << ": token " << i << " differs\n  Lexer:         " << a.toString()
+                 << "\n  ParallelLexer: " << b.toString() << endl;
+            return false;
+        }
+    }
+    if (expected.size() != actual.size()) {
+        cerr << name << ": " << expected.size() << " tokens vs " << actual.size() << endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    size_t megabytes = argc > 1 ? strtoull(argv[1], nullptr, 10) : 64;
+
+    bool ok = true;
+    for (size_t chunkBytes : {1, 3, 16, 64, 256}) {
+        ok &= check(SAMPLE_PROGRAM, 4, chunkBytes, "sample/" + to_string(chunkBytes));
+    }
+
+    const char alphabet[] = "  \n\n\tab_Z09.\"\"\\\\+=<!&|{};,//**'";
+    mt19937 rng(11);
+    for (int i = 0; i < 20000 && ok; ++i) {
+        string soup(rng() % 200, ' ');
+        for (char &c : soup) c = alphabet[rng() % (sizeof(alphabet) - 1)];
+        ok &= check(soup, 1 + rng() % 4, 1 + rng() % 24, "random input " + to_string(i));
+    }
+    if (!ok) return 1;
+    cout << "Token streams match" << endl;
+
+    string corpus;
+    for (int i = 0; corpus.size() < megabytes << 20; ++i) {
+        corpus += SAMPLE_PROGRAM;
+        if (i % 16 == 0) corpus += "string banner = \"spans\n several\n lines\";\n";
+    }
+    unsigned cores = thread::hardware_concurrency();
+    cout << "Lexing " << corpus.size() / 1e6 << " MB; hardware_concurrency() = " << cores << endl;
+
+    double serialSeconds = 0;
+    for (size_t threads = 1; threads <= max<size_t>(ThreadPool::defaultThreads(), 8); threads *= 2) {
+        Interner interner;
+        ParallelLexer lexer(corpus, interner, threads);
+        auto begin = chrono::steady_clock::now();
+        size_t count = lexer.tokenize().size();
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+        if (threads == 1) serialSeconds = seconds;
+        cout << setw(3) << threads << " threads" << fixed << setprecision(1) << setw(10)
+             << corpus.size() / seconds / 1e6 << " MB/s" << setw(10) << count / seconds / 1e6 << " Mtokens/s";
+        if (threads <= max(cores, 1u)) {
+            cout << setprecision(2) << setw(8) << serialSeconds / seconds << "x" << endl;
+        } else {
+            cout << "   (more threads than cores: no speedup figure)" << endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,186 @@
+// Checks that ParallelParser builds the same tree and reports the same
+// errors as Parser, then times it at increasing thread counts.
+//
+//     g++ -std=c++17 -O2 -pthread parallel_parser_bench.cpp -o parallel_parser_bench
+//     ./parallel_parser_bench [functions]
+//
+// The correctness runs use batches of a single token, so the vector is cut
+// at every function the pre-scan finds. Besides the sample, they parse
+// programs of many functions with comments and character literals holding
+// braces (which must not reach the pre-scan as braces) and the same programs
+// with random bytes deleted or repeated, most of which have syntax errors and must fall
+// back to one Parser; half the programs are parsed in each ParseMode.
+// Throughput runs parse the sample's functions, renamed and repeated the
+// requested number of times (default 20,000), with the default batch size.
+// A speedup is only printed for thread counts the machine has cores for
+// (std::thread::hardware_concurrency()); beyond that the threads share cores
+// and the ratio is noise.
+
+#define KABIR_NO_MAIN
+#include "../Final Code & Report/Complete-code.cpp"
+
+#include <chrono>
+#include <random>
+
+// Walks both trees side by side, with a stack rather than by recursion. Node
+// indices differ between the two, so a for loop's step is followed like a
+// child rather than compared.
+static bool sameTree(const SyntaxTree &a, const SyntaxTree &b) {
+    vector<pair<uint32_t, uint32_t>> pending{{a.root, b.root}};
+    while (!pending.empty()) {
+        auto [i, j] = pending.back();
+        pending.pop_back();
+        if ((i == SyntaxNode::NONE) != (j == SyntaxNode::NONE)) return false;
+        if (i == SyntaxNode::NONE) continue;
+        const SyntaxNode &x = a[i], &y = b[j];
+        if (x.kind != y.kind || x.op != y.op || x.flags != y.flags || x.line != y.line) return false;
+        if (x.kind == SYNTAX_FOR) {
+            pending.push_back({x.extra, y.extra});
+        } else if (x.integer != y.integer) {
+            return false;
+        }
+        pending.push_back({x.next, y.next});
+        for (int c = 0; c < 3; ++c) pending.push_back({x.child[c], y.child[c]});
+    }
+    return true;
+}
+
+static bool sameErrors(const vector<SyntaxError> &a, const vector<SyntaxError> &b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].line != b[i].line || a[i].column != b[i].column || a[i].message != b[i].message) return false;
+    }
+    return true;
+}
+
+// Parses `source` both ways; false if they differ. `batched` counts the
+// sources that were parsed in more than one batch.
+static bool check(const string &source, ParseMode mode, const string &name, size_t &batched) {
+    Interner serialNames, parallelNames;
+    vector<Token> serialTokens = Lexer(source, serialNames).tokenize();
+    vector<Token> parallelTokens = Lexer(source, parallelNames).tokenize();
+
+    ParallelParser serial(serialTokens, serialNames, nullptr, mode, 1);
+    ParallelParser parallel(parallelTokens, parallelNames, nullptr, mode, 4, 1);
+    SyntaxTree expected = serial.parse();
+    SyntaxTree actual = parallel.parse();
+    if (parallel.batchCount() > 1) batched++;
+
+    if (!sameErrors(serial.errors(), parallel.errors())) {
+        cerr << name << ": " << serial.errors().size() << " errors vs " << parallel.errors().size() << endl;
+        return false;
+    }
+    if (serial.errors().empty()) {
+        if (!sameTree(expected, actual) || serialNames.size() != parallelNames.size()) {
+            cerr << name << ": the trees differ" << endl;
+            return false;
+        }
+        return true;
+    }
+    // After a fallback, ids can differ: strings were interned ahead, and the
+    // failed batches may have interned names on their way to an error. The
+    // trees must still print the same.
+    ostringstream expectedText, actualText;
+    expected.format(expectedText, serialNames);
+    actual.format(actualText, parallelNames);
+    if (expectedText.str() != actualText.str()) {
+        cerr << name << ": the trees differ" << endl;
+        return false;
+    }
+    return true;
+}
+
+// The sample with its two functions renamed after `i`.
+static string renamedSample(size_t i) {
+    string source = SAMPLE_PROGRAM;
+    string suffix = to_string(i);
+    source.replace(source.find("int main()"), 10, "int main" + suffix + "()");
+    size_t call = source.find("testFunction();");
+    source.replace(call, 12, "testFunction" + suffix);
+    size_t definition = source.find("void testFunction()");
+    source.replace(definition, 17, "void testFunction" + suffix);
+    return source;
+}
+
+// Functions, top-level declarations and prototypes, with braces hidden in
+// comments and character literals.
+static string mixedProgram(mt19937 &rng, size_t functions) {
+    static const char *const pieces[] = {
+        "int counter = 0;\n",
+        "struct Point { int x; int y; Point(int v) : x(v) {} };\n",
+        "void prototype(int a);\n",
+        "// int fake() { is not a function\n",
+        "/* } unbalanced { in a block comment */\n",
+    };
+    static const char *const bodies[] = {
+        "    char open = '{';\n    char close = '}';\n",
+        "    // } a closing brace in a comment\n    x = x + 1;\n",
+        "    if (x > 1) { for (int i = 0; i < x; i++) { x -= i; } } else { x = 0; }\n",
+        "    /* { */ while (x < 10) { x++; }\n",
+        "    switch (x) { case 1: x = 2; break; default: break; }\n",
+        "    string s = \"} {\";\n",
+    };
+    string source;
+    for (size_t f = 0; f < functions; ++f) {
+        if (rng() % 3 == 0) source += pieces[rng() % (sizeof(pieces) / sizeof(pieces[0]))];
+        source += "int f" + to_string(f) + "(int x, char *p) {\n";
+        for (int s = rng() % 4; s >= 0; --s) source += bodies[rng() % (sizeof(bodies) / sizeof(bodies[0]))];
+        source += "    return x;\n}\n";
+    }
+    return source;
+}
+
+int main(int argc, char *argv[]) {
+    size_t functions = argc > 1 ? strtoull(argv[1], nullptr, 10) : 20000;
+
+    bool ok = true;
+    size_t batched = 0;
+    ok &= check(SAMPLE_PROGRAM, RECURSIVE_DESCENT, "sample", batched);
+    mt19937 rng(25);
+    for (int i = 0; i < 2000 && ok; ++i) {
+        ParseMode mode = i % 2 ? EXPLICIT_STACK : RECURSIVE_DESCENT;
+        string source = mixedProgram(rng, 1 + rng() % 12);
+        ok &= check(source, mode, "program " + to_string(i), batched);
+        for (int edits = 1 + rng() % 3; edits > 0; --edits) {
+            size_t at = rng() % source.size();
+            if (rng() % 2) {
+                source.erase(at, 1 + rng() % 3);
+            } else {
+                source.insert(at, 1, source[at]);
+            }
+        }
+        ok &= check(source, mode, "mutated program " + to_string(i), batched);
+    }
+    if (!ok) return 1;
+    cout << "Trees and errors match (" << batched << " of 4001 sources parsed in batches)" << endl;
+
+    string corpus;
+    for (size_t i = 0; i < functions; ++i) corpus += renamedSample(i);
+    Interner interner;
+    vector<Token> tokens = Lexer(corpus, interner).tokenize();
+    unsigned cores = thread::hardware_concurrency();
+    cout << "Parsing " << functions * 2 << " functions, " << tokens.size() << " tokens; hardware_concurrency() = "
+         << cores << endl;
+
+    double serialSeconds = 0;
+    for (size_t threads = 1; threads <= max<size_t>(ThreadPool::defaultThreads(), 8); threads *= 2) {
+        Arena arena;
+        ParallelParser parser(tokens, interner, &arena, RECURSIVE_DESCENT, threads);
+        auto begin = chrono::steady_clock::now();
+        SyntaxTree tree = parser.parse();
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+        if (threads == 1) serialSeconds = seconds;
+        if (!parser.errors().empty()) {
+            cerr << "unexpected syntax errors" << endl;
+            return 1;
+        }
+        cout << setw(3) << threads << " threads" << setw(5) << parser.batchCount() << " batches" << fixed
+             << setprecision(1) << setw(10) << tokens.size() / seconds / 1e6 << " Mtokens/s";
+        if (threads <= max(cores, 1u)) {
+            cout << setprecision(2) << setw(8) << serialSeconds / seconds << "x" << endl;
+        } else {
+            cout << "   (more threads than cores: no speedup figure)" << endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,100 @@
+// Compares ScopedSymbolTable with the two map-based tables it replaced, on
+// a function with many locals declared across nested blocks, each block
+// checking and then using its names before it is left.
+//
+//     g++ -std=c++17 -O2 scoped_symbol_table_bench.cpp -o scoped_symbol_table_bench
+//     ./scoped_symbol_table_bench [locals]
+//
+// "map + copy" is a std::map copied on block entry and restored on exit (the
+// usual way to add scopes to TAC.cpp's table); "unordered_map stack" keeps one
+// unordered_map<string, ...> per open block and looks names up innermost
+// first.
+
+#include "../common/interner.h"
+#include "../common/scoped_symbol_table.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+static const int BLOCKS = 64;  // Nested blocks in the function body
+
+template <typename Run>
+static void time(const char *name, size_t operations, Run run) {
+    auto begin = chrono::steady_clock::now();
+    size_t found = run();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+    cout << "  " << left << setw(22) << name << right << fixed << setprecision(1) << setw(10)
+         << operations / seconds / 1e6 << " Mops/s   (" << found << ")" << endl;
+}
+
+int main(int argc, char *argv[]) {
+    size_t locals = argc > 1 ? strtoull(argv[1], nullptr, 10) : 20000;
+    size_t perBlock = locals / BLOCKS;
+
+    vector<string> names;
+    for (size_t i = 0; i < locals; ++i) names.push_back("local" + to_string(i));
+    Interner interner;
+    vector<uint32_t> ids;
+    for (const string &name : names) ids.push_back(interner.intern(name));
+
+    // Per block: declare its names, look up every name visible so far, leave.
+    size_t operations = 0;
+    for (int b = 0; b < BLOCKS; ++b) operations += perBlock + perBlock * (b + 1);
+
+    cout << locals << " locals in " << BLOCKS << " nested blocks" << endl;
+
+    time("map + copy", operations, [&] {
+        map<string, string> table;
+        vector<map<string, string>> saved;
+        size_t found = 0;
+        for (int b = 0; b < BLOCKS; ++b) {
+            saved.push_back(table);
+            for (size_t i = b * perBlock; i < (b + 1) * perBlock; ++i) table[names[i]] = "int";
+            for (size_t i = 0; i < (b + 1) * perBlock; ++i) found += table.count(names[i]);
+        }
+        while (!saved.empty()) {
+            table = saved.back();
+            saved.pop_back();
+        }
+        return found;
+    });
+
+    time("unordered_map stack", operations, [&] {
+        vector<unordered_map<string, string>> scopes(1);
+        size_t found = 0;
+        for (int b = 0; b < BLOCKS; ++b) {
+            scopes.emplace_back();
+            for (size_t i = b * perBlock; i < (b + 1) * perBlock; ++i) scopes.back()[names[i]] = "int";
+            for (size_t i = 0; i < (b + 1) * perBlock; ++i) {
+                for (auto scope = scopes.rbegin(); scope != scopes.rend(); ++scope) {
+                    if (scope->count(names[i])) {
+                        found++;
+                        break;
+                    }
+                }
+            }
+        }
+        while (scopes.size() > 1) scopes.pop_back();
+        return found;
+    });
+
+    time("ScopedSymbolTable", operations, [&] {
+        ScopedSymbolTable<const char *> table;
+        size_t found = 0;
+        for (int b = 0; b < BLOCKS; ++b) {
+            table.enterScope();
+            for (size_t i = b * perBlock; i < (b + 1) * perBlock; ++i) table.declare(ids[i], "int");
+            for (size_t i = 0; i < (b + 1) * perBlock; ++i) found += table.lookup(ids[i]) != nullptr;
+        }
+        for (int b = 0; b < BLOCKS; ++b) table.exitScope();
+        return found;
+    });
+    return 0;
+}
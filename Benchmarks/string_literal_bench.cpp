@@ -0,0 +1,99 @@
+// Times Lexer and DfaLexer on a source that is mostly string tables, at each
+// SIMD level, after checking that every level produces the same tokens.
+//
+//     g++ -std=c++17 -O2 -pthread string_literal_bench.cpp -o string_literal_bench
+//     ./string_literal_bench [megabytes]
+//
+// Each line is a declaration initialised with a 40-200 byte literal; one in
+// eight literals has escapes, spread through the text, and a few span lines.
+// Both lexers are timed through tokenize(), vector included.
+
+#define KABIR_NO_MAIN
+#include "../Final Code & Report/Complete-code.cpp"
+
+#include <chrono>
+#include <random>
+
+static bool same(const vector<Token> &a, const vector<Token> &b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].type != b[i].type || a[i].value != b[i].value || a[i].line != b[i].line ||
+            a[i].column != b[i].column || a[i].offset != b[i].offset || a[i].length != b[i].length) {
+            cerr << "token " << i << " differs: " << a[i].toString() << " vs " << b[i].toString() << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Tokenize>
+static void time(const string &name, const string &source, Tokenize tokenize) {
+    double best = 1e30;
+    size_t count = 0;
+    for (int round = 0; round < 3; ++round) {
+        auto begin = chrono::steady_clock::now();
+        count = tokenize();
+        best = min(best, chrono::duration<double>(chrono::steady_clock::now() - begin).count());
+    }
+    cout << "  " << left << setw(18) << name << right << fixed << setprecision(1) << setw(8)
+         << source.size() / best / 1e6 << " MB/s   (" << count << " tokens)" << endl;
+}
+
+int main(int argc, char *argv[]) {
+    size_t megabytes = argc > 1 ? strtoull(argv[1], nullptr, 10) : 32;
+
+    mt19937 rng(15);
+    const char words[] = "abcdefghijklmnopqrstuvwxyz ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789,.:;!?-_()[]{}";
+    string corpus = SAMPLE_PROGRAM;
+    for (size_t i = 0; corpus.size() < megabytes << 20; ++i) {
+        corpus += "string entry" + to_string(i) + " = \"";
+        size_t length = 40 + rng() % 160;
+        bool escapes = rng() % 8 == 0;
+        for (size_t j = 0; j < length; ++j) {
+            if (escapes && rng() % 24 == 0) {
+                corpus += "\\\\\\n\\t\\\""[2 * (rng() % 4)];
+                corpus += "\\\\\\n\\t\\\""[2 * (rng() % 4) + 1];
+            } else if (rng() % 4096 == 0) {
+                corpus += '\n';
+            } else {
+                corpus += words[rng() % (sizeof(words) - 1)];
+            }
+        }
+        corpus += "\";\n";
+    }
+
+    vector<simd::Level> levels;
+    for (simd::Level level : {simd::SCALAR, simd::SSE2, simd::AVX2}) {
+        if (level <= simd::level()) levels.push_back(level);
+    }
+    simd::Level best = simd::level();
+
+    Interner interner;
+    simd::setLevel(simd::SCALAR);
+    Lexer reference(corpus, interner);
+    vector<Token> expected = reference.tokenize();
+    for (simd::Level level : levels) {
+        simd::setLevel(level);
+        Lexer lexer(corpus, interner);
+        DfaLexer dfaLexer(corpus, interner);
+        if (!same(expected, lexer.tokenize()) || !same(expected, dfaLexer.tokenize())) {
+            cerr << "tokens differ at level " << simd::levelName(level) << endl;
+            return 1;
+        }
+    }
+    cout << "Token streams match; " << corpus.size() / 1e6 << " MB" << endl;
+
+    for (simd::Level level : levels) {
+        simd::setLevel(level);
+        time(string("Lexer ") + simd::levelName(level), corpus, [&] {
+            Lexer lexer(corpus, interner);
+            return lexer.tokenize().size();
+        });
+        time(string("DfaLexer ") + simd::levelName(level), corpus, [&] {
+            DfaLexer lexer(corpus, interner);
+            return lexer.tokenize().size();
+        });
+    }
+    simd::setLevel(best);
+    return 0;
+}
@@ -0,0 +1,159 @@
+// Compares vector<Token> with the struct-of-arrays TokenBuffer: memory per
+// token, a parser-style scan over token kinds, and the full intermediate code
+// generator. The scan reads one byte per token and is where the buffer wins;
+// the parser needs every field of every token, so the generator rebuilds
+// each Token from the arrays and runs no faster than from the vector, whose
+// Tokens it only copies. Cache misses come from perf_event_open on Linux; elsewhere, or
+// when perf events are not permitted, only times are shown.
+//
+//     g++ -std=c++17 -O2 -pthread token_buffer_bench.cpp -o token_buffer_bench
+//     ./token_buffer_bench [megabytes]
+
+#define KABIR_NO_MAIN
+#include "../Final Code & Report/Complete-code.cpp"
+
+#include <chrono>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+class CacheMissCounter {
+public:
+    CacheMissCounter() {
+#ifdef __linux__
+        perf_event_attr attr{};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+    }
+
+    ~CacheMissCounter() {
+#ifdef __linux__
+        if (fd >= 0) close(fd);
+#endif
+    }
+
+    bool available() const {
+        return fd >= 0;
+    }
+
+    void start() {
+#ifdef __linux__
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    long long stop() {
+        long long count = -1;
+#ifdef __linux__
+        if (fd < 0) return -1;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &count, sizeof(count)) != sizeof(count)) count = -1;
+#endif
+        return count;
+    }
+
+private:
+    int fd = -1;
+};
+
+class VectorReplay {
+public:
+    explicit VectorReplay(const vector<Token> &tokens) : tokens(tokens) {}
+
+    Token nextToken() {
+        return pos < tokens.size() ? tokens[pos++] : tokens.back();
+    }
+
+private:
+    const vector<Token> &tokens;
+    size_t pos = 0;
+};
+
+static CacheMissCounter counter;
+
+template <typename Run>
+static void measure(const char *name, size_t tokenCount, Run run) {
+    counter.start();
+    auto begin = chrono::steady_clock::now();
+    size_t result = run();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+    long long misses = counter.stop();
+
+    cout << "  " << left << setw(28) << name << right << fixed << setprecision(1) << setw(8)
+         << tokenCount / seconds / 1e6 << " Mtokens/s";
+    if (misses >= 0) cout << setw(12) << misses << " cache misses";
+    cout << "   (" << result << ")" << endl;
+}
+
+int main(int argc, char *argv[]) {
+    size_t megabytes = argc > 1 ? strtoull(argv[1], nullptr, 10) : 64;
+
+    string corpus;
+    while (corpus.size() < megabytes << 20) corpus += SAMPLE_PROGRAM;
+
+    Interner interner;
+    Lexer lexer(corpus, interner);
+    vector<Token> tokens = lexer.tokenize();
+    TokenBuffer buffer(corpus);
+    buffer.reserve(tokens.size());
+    for (const Token &token : tokens) buffer.push_back(token);
+
+    // Both representations must drive the generator to the same output.
+    IntermediateCodeGenerator generator(interner);
+    VectorReplay replay(tokens);
+    TokenStream<VectorReplay> stream(replay);
+    auto fromVector = generator.generate(stream);
+    auto fromBuffer = generator.generate(buffer);
+    bool same = fromVector.size() == fromBuffer.size();
+    for (size_t i = 0; same && i < fromVector.size(); ++i) {
+        same = fromVector[i].toString(interner) == fromBuffer[i].toString(interner);
+    }
+    if (!same) {
+        cerr << "TokenBuffer and vector<Token> generate different code" << endl;
+        return 1;
+    }
+
+    cout << corpus.size() / 1e6 << " MB, " << tokens.size() << " tokens; " << sizeof(Token)
+         << " bytes per Token vs 21 in TokenBuffer" << endl;
+    if (!counter.available()) cout << "(perf events unavailable; cache misses not shown)" << endl;
+
+    // A parser's inner loop: find declarations "type identifier =".
+    measure("scan vector<Token>", tokens.size(), [&] {
+        size_t found = 0;
+        for (size_t i = 0; i + 2 < tokens.size(); ++i) {
+            found += (tokens[i].type == INT || tokens[i].type == FLOAT) && tokens[i + 1].type == IDENTIFIER &&
+                     tokens[i + 2].type == ASSIGN;
+        }
+        return found;
+    });
+    measure("scan TokenBuffer kinds", tokens.size(), [&] {
+        const uint8_t *kinds = buffer.kinds();
+        size_t found = 0;
+        for (size_t i = 0; i + 2 < buffer.size(); ++i) {
+            found += (kinds[i] == INT || kinds[i] == FLOAT) && kinds[i + 1] == IDENTIFIER && kinds[i + 2] == ASSIGN;
+        }
+        return found;
+    });
+
+    measure("generate from vector<Token>", tokens.size(), [&] {
+        VectorReplay replay(tokens);
+        TokenStream<VectorReplay> stream(replay);
+        return generator.generate(stream).size();
+    });
+    measure("generate from TokenBuffer", tokens.size(), [&] {
+        return generator.generate(buffer).size();
+    });
+    return 0;
+}
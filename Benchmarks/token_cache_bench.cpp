@@ -0,0 +1,108 @@
+// Times lexing a source against loading its tokens from the token cache,
+// after checking that the cached tokens match the lexer's exactly.
+//
+//     g++ -std=c++17 -O2 -pthread token_cache_bench.cpp -o token_cache_bench
+//     ./token_cache_bench [megabytes] [cache directory]
+//
+// The corpus is the sample program repeated, with escaped string literals
+// mixed in so the decoded-value section is exercised. "Load" includes
+// mapping the file, checking its hash, and interning the cached names.
+
+#define KABIR_NO_MAIN
+#include "../Final Code & Report/Complete-code.cpp"
+
+#include <chrono>
+
+static bool same(const vector<Token> &a, const Interner &na, const vector<Token> &b, const Interner &nb) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        bool sameSymbol = a[i].symbol == NO_SYMBOL ? b[i].symbol == NO_SYMBOL
+                                                   : b[i].symbol != NO_SYMBOL && na.name(a[i].symbol) == nb.name(b[i].symbol);
+        if (a[i].type != b[i].type || a[i].value != b[i].value || a[i].line != b[i].line ||
+            a[i].column != b[i].column || a[i].offset != b[i].offset || a[i].length != b[i].length ||
+            a[i].number.integer != b[i].number.integer || !sameSymbol) {
+            cerr << "token " << i << " differs: " << a[i].toString() << " vs " << b[i].toString() << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Run>
+static double best(Run run) {
+    double fastest = 1e30;
+    for (int round = 0; round < 5; ++round) {
+        auto begin = chrono::steady_clock::now();
+        run();
+        fastest = min(fastest, chrono::duration<double>(chrono::steady_clock::now() - begin).count());
+    }
+    return fastest;
+}
+
+int main(int argc, char *argv[]) {
+    size_t megabytes = argc > 1 ? strtoull(argv[1], nullptr, 10) : 16;
+    string directory = argc > 2 ? argv[2] : "token_cache_bench.cache";
+
+    string corpus;
+    for (size_t i = 0; corpus.size() < megabytes << 20; ++i) {
+        corpus += SAMPLE_PROGRAM;
+        corpus += "string note" + to_string(i) + " = \"tab\\there, quote \\\" and newline\\n\";\n";
+    }
+    string path = tokenCachePath(directory, corpus);
+
+    Interner lexed;
+    Lexer lexer(corpus, lexed);
+    vector<Token> expected = lexer.tokenize();
+    {
+        Lexer source(corpus, lexed);
+        TokenCacheRecorder<Lexer> recorder(source, corpus, lexed);
+        while (recorder.nextToken().type != END_OF_FILE) {}
+        if (!recorder.write(path)) {
+            cerr << "could not write " << path << endl;
+            return 1;
+        }
+    }
+
+    Interner loaded;
+    TokenCacheFile cache;
+    if (!cache.open(path, corpus)) {
+        cerr << "could not load " << path << endl;
+        return 1;
+    }
+    CachedTokens cached(cache, corpus, loaded);
+    if (!same(expected, lexed, cached.tokenize(), loaded)) return 1;
+
+    const TokenCacheHeader &info = cache.info();
+    cout << "Cached tokens match; " << corpus.size() / 1e6 << " MB source, " << info.tokenCount << " tokens, "
+         << filesystem::file_size(path) / 1e6 << " MB cache, " << setprecision(2)
+         << (double)filesystem::file_size(path) / corpus.size() << "x the source (" << info.lineCount << " line entries, "
+         << info.nameCount << " names, " << info.decodedCount << " decoded literals)" << endl;
+
+    auto report = [&](const char *name, double seconds) {
+        cout << "  " << left << setw(22) << name << right << fixed << setprecision(2) << setw(8)
+             << seconds * 1e3 << " ms" << endl;
+    };
+    report("hash source", best([&] { volatile uint64_t hash = contentHash(corpus); (void)hash; }));
+    report("lex", best([&] {
+        Interner interner;
+        Lexer lexer(corpus, interner);
+        while (lexer.nextToken().type != END_OF_FILE) {}
+    }));
+    report("lex, record and write", best([&] {
+        Interner interner;
+        Lexer lexer(corpus, interner);
+        TokenCacheRecorder<Lexer> recorder(lexer, corpus, interner);
+        while (recorder.nextToken().type != END_OF_FILE) {}
+        recorder.write(path);
+    }));
+    report("load", best([&] {
+        Interner interner;
+        TokenCacheFile file;
+        file.open(path, corpus);
+        CachedTokens tokens(file, corpus, interner);
+        while (tokens.nextToken().type != END_OF_FILE) {}
+    }));
+
+    filesystem::remove_all(directory);
+    return 0;
+}
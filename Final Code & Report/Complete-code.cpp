@@ -1,11 +1,33 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <deque>
+#include <cstdint>
 #include <unordered_map>
 #include <iomanip>
 #include <sstream>
 #include <stack> 
 #include <stdexcept>
+#include <cassert>
+#include <memory>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <mutex>
+#include "../common/mapped_file.h"
+#include "../common/simd_scan.h"
+#include "../common/keyword_table.h"
+#include "../common/interner.h"
+#include "../common/thread_pool.h"
+#include "../common/token_stream.h"
+#include "../common/scoped_symbol_table.h"
+#include "../common/arena.h"
+#include "../common/number_literal.h"
+#include "../common/dump_writer.h"
+#include "../common/token_cache.h"
+#include "../common/phase_stats.h"
 // #define AND &&
 
 using namespace std;
@@ -66,482 +88,4683 @@ enum TokenType {
     MEMBER_ACCESS , 
     OR,
     AND, 
-    STRUCT
+    STRUCT,
+    CHAR_LITERAL,
+    DOT,
+    COLON,
+    SHIFT_LEFT,
+    SHIFT_RIGHT,
+    PLUS_ASSIGN,
+    MINUS_ASSIGN,
+    MULTIPLY_ASSIGN,
+    DIVIDE_ASSIGN,
+    MODULO_ASSIGN,
+    INCREMENT,
+    DECREMENT
+};
+
+const uint32_t NO_SYMBOL = Interner::NOT_FOUND;
+
+// Dump name of each TokenType, indexed by the enum.
+inline const char *tokenTypeName(TokenType type) {
+    static const char *const names[] = {
+        "PLUS", "MINUS", "MULTIPLY", "DIVIDE", "MODULO", "ASSIGN", "EQUAL", "NOT_EQUAL", "LESS_THAN",
+        "GREATER_THAN", "LESS_EQUAL", "GREATER_EQUAL", "IF", "ELSE", "WHILE", "FOR", "RETURN", "INT",
+        "FLOAT", "DOUBLE", "CHAR", "STRING", "VOID", "IDENTIFIER", "INTEGER_LITERAL", "FLOAT_LITERAL",
+        "STRING_LITERAL", "SEMICOLON", "COMMA", "LEFT_PAREN", "RIGHT_PAREN", "LEFT_BRACE", "RIGHT_BRACE",
+        "LOGICAL_AND", "LOGICAL_OR", "LOGICAL_NOT", "END_OF_FILE", "UNKNOWN", "BREAK", "CONTINUE", "SWITCH",
+        "CASE", "DEFAULT", "PUBLIC", "PRIVATE", "PROTECTED", "TRY", "CATCH", "THROW", "&", "*", "->", "OR",
+        "AND", "STRUCT", "CHAR_LITERAL", "DOT", "COLON", "SHIFT_LEFT", "SHIFT_RIGHT", "PLUS_ASSIGN",
+        "MINUS_ASSIGN", "MULTIPLY_ASSIGN", "DIVIDE_ASSIGN", "MODULO_ASSIGN", "INCREMENT", "DECREMENT"
+    };
+    static_assert(sizeof(names) / sizeof(names[0]) == DECREMENT + 1, "one name per TokenType");
+    return (size_t)type < sizeof(names) / sizeof(names[0]) ? names[type] : "UNKNOWN";
+}
+
+// Binary value of a numeric literal, evaluated by the lexer.
+union NumberValue {
+    uint64_t integer;  // INTEGER_LITERAL; the character code of a CHAR_LITERAL
+    double real;       // FLOAT_LITERAL; already rounded to float for an 'f' suffix
 };
 
 // Token Structure
+// `value` is a view, not a copy: it points into the lexer's source buffer, or
+// into the lexer's literal pool for string literals that needed escape
+// decoding. `offset`/`length` locate the whole lexeme in the source. Tokens
+// are only valid while the Lexer that produced them is alive. Identifiers
+// also carry their interned `symbol` id; other tokens have NO_SYMBOL.
+// Numeric and character literals carry their `number`; for other tokens it
+// is zero.
 struct Token {
     TokenType type;
-    string value;
+    uint32_t symbol;
+    string_view value;
     int line, column;
+    uint32_t offset, length;
+    NumberValue number;
+
+    string text() const {
+        return string(value);
+    }
+
+    // "Token{type: NAME, value: 'text', line: L, column: C}", to any stream
+    // with operator<< (an ostream, or a DumpWriter for bulk dumps).
+    template <typename Out>
+    void format(Out &out) const {
+        out << "Token{type: " << tokenTypeName(type) << ", value: '" << value << "', line: " << line
+            << ", column: " << column << "}";
+    }
 
     string toString() const {
-        static const unordered_map<TokenType, string> typeNames = {
-            {OR, "OR"},
-            {AND, "AND"},
-            {PLUS, "PLUS"},
-            {MINUS, "MINUS"}, 
-            {MULTIPLY, "MULTIPLY"},
-            {DIVIDE, "DIVIDE"}, 
-            {MODULO, "MODULO"}, 
-            {ASSIGN, "ASSIGN"},
-            {EQUAL, "EQUAL"}, 
-            {NOT_EQUAL, "NOT_EQUAL"}, 
-            {LESS_THAN, "LESS_THAN"},
-            {GREATER_THAN, "GREATER_THAN"}, 
-            {LESS_EQUAL, "LESS_EQUAL"},
-            {GREATER_EQUAL, "GREATER_EQUAL"}, 
-            {IF, "IF"}, 
-            {ELSE, "ELSE"},
-            {WHILE, "WHILE"}, 
-            {FOR, "FOR"}, 
-            {RETURN, "RETURN"},
-            {INT, "INT"}, 
-            {FLOAT, "FLOAT"}, 
-            {DOUBLE, "DOUBLE"},
-            {CHAR, "CHAR"}, 
-            {STRING, "STRING"}, 
-            {VOID, "VOID"},
-            {IDENTIFIER, "IDENTIFIER"}, 
-            {INTEGER_LITERAL, "INTEGER_LITERAL"},
-            {FLOAT_LITERAL, "FLOAT_LITERAL"}, 
-            {STRING_LITERAL, "STRING_LITERAL"},
-            {SEMICOLON, "SEMICOLON"}, 
-            {COMMA, "COMMA"},
-            {LEFT_PAREN, "LEFT_PAREN"}, 
-            {RIGHT_PAREN, "RIGHT_PAREN"},
-            {LEFT_BRACE, "LEFT_BRACE"}, 
-            {RIGHT_BRACE, "RIGHT_BRACE"},
-            {LOGICAL_AND, "LOGICAL_AND"}, 
-            {LOGICAL_OR, "LOGICAL_OR"},
-            {LOGICAL_NOT, "LOGICAL_NOT"}, 
-            {END_OF_FILE, "END_OF_FILE"},
-            {STRUCT, "STRUCT"},
-            {UNKNOWN, "UNKNOWN"},
-            {BREAK, "BREAK"},
-            {CONTINUE, "CONTINUE"}, 
-            {SWITCH, "SWITCH"}, 
-            {CASE, "CASE"}, 
-            {DEFAULT, "DEFAULT"}, 
-            {PUBLIC, "PUBLIC"}, 
-            {PRIVATE, "PRIVATE"}, 
-            {PROTECTED, "PROTECTED"}, 
-            {TRY, "TRY"}, 
-            {CATCH, "CATCH"}, 
-            {THROW, "THROW"}, 
-            {REFERENCE, "&"}, 
-            {DEREFERENCE, "*"}, 
-            {MEMBER_ACCESS, "->"}
-        };
+        ostringstream out;
+        format(out);
+        return out.str();
+    }
+};
+
+// Tokens whose `number` is set: numeric and character literals.
+inline bool hasNumber(TokenType type) {
+    return type == INTEGER_LITERAL || type == FLOAT_LITERAL || type == CHAR_LITERAL;
+}
+
+inline NumberValue numberValue(const NumberLiteral &literal) {
+    NumberValue value{};
+    if (literal.floating) {
+        value.real = literal.real;
+    } else {
+        value.integer = literal.integer;
+    }
+    return value;
+}
+
+// Maps the character after a backslash in a string literal to the character
+// it stands for.
+inline char unescape(char escaped) {
+    switch (escaped) {
+        case 'n': return '\n';
+        case 't': return '\t';
+        default: return escaped;  // Covers \\ and \"
+    }
+}
+
+// Newlines in [p, end), and where the last one is.
+inline size_t countNewlines(const char *p, const char *end, const char *&lastNewline) {
+    size_t newlines = 0;
+    while ((p = simd::findByte(p, end, '\n')) != end) {
+        newlines++;
+        lastNewline = p++;
+    }
+    return newlines;
+}
+
+// Rebuilds a token's value from its lexeme in `source`. Only string literals
+// with escapes have a value that is not a slice of the source.
+// The token must lie within `source`; nothing is bounds-checked.
+inline string_view tokenValue(string_view source, TokenType type, uint32_t offset, uint32_t length) {
+    string_view lexeme(source.data() + offset, length);
+    switch (type) {
+        case STRING_LITERAL:
+        case CHAR_LITERAL: return string_view(lexeme.data() + 1, length - 2);
+        case END_OF_FILE: return string_view();
+        case UNKNOWN: return !lexeme.empty() && lexeme[0] == '"' ? string_view() : lexeme;  // Unterminated literal
+        default: return lexeme;
+    }
+}
+
+// Struct-of-arrays token storage: one parallel array per field, so a pass that
+// only looks at kinds streams through one byte per token instead of a 48-byte
+// Token. Values are not stored; they are rebuilt from the source, except for
+// decoded string literals and numeric values, which are kept in short side
+// lists. 21 bytes per token in flat arrays, plus the side lists.
+class TokenBuffer {
+private:
+    string_view source;
+    vector<uint8_t> kindArray;
+    vector<uint32_t> symbols;
+    vector<uint32_t> offsets;
+    vector<uint32_t> lengths;
+    vector<int32_t> lines;
+    vector<int32_t> columns;
+    vector<pair<uint32_t, string_view>> decoded;  // (index, value), in index order
+    vector<pair<uint32_t, NumberValue>> numbers;  // (index, value) of literals with a number, in index order
+
+public:
+    explicit TokenBuffer(string_view source) : source(source) {}
+
+    void reserve(size_t n) {
+        kindArray.reserve(n);
+        symbols.reserve(n);
+        offsets.reserve(n);
+        lengths.reserve(n);
+        lines.reserve(n);
+        columns.reserve(n);
+    }
+
+    // Decoded literal values are referenced, not copied: they must outlive
+    // the buffer, as they would a vector<Token>.
+    void push_back(const Token &token) {
+        if (token.type == STRING_LITERAL && token.value.data() &&
+            (token.value.data() < source.data() || token.value.data() > source.data() + source.size())) {
+            decoded.push_back({(uint32_t)kindArray.size(), token.value});
+        }
+        if (hasNumber(token.type)) {
+            numbers.push_back({(uint32_t)kindArray.size(), token.number});
+        }
+        kindArray.push_back((uint8_t)token.type);
+        symbols.push_back(token.symbol);
+        offsets.push_back(token.offset);
+        lengths.push_back(token.length);
+        lines.push_back(token.line);
+        columns.push_back(token.column);
+    }
+
+    size_t size() const {
+        return kindArray.size();
+    }
+
+    // For hot loops: kinds()[i] is the TokenType of token i.
+    const uint8_t *kinds() const {
+        return kindArray.data();
+    }
+
+    TokenType kind(size_t i) const {
+        return (TokenType)kindArray[i];
+    }
+
+    uint32_t symbol(size_t i) const {
+        return symbols[i];
+    }
+
+    string_view value(size_t i) const {
+        if (kindArray[i] == STRING_LITERAL && !decoded.empty()) {
+            auto it = lower_bound(decoded.begin(), decoded.end(), make_pair((uint32_t)i, string_view()),
+                                  [](const auto &a, const auto &b) { return a.first < b.first; });
+            if (it != decoded.end() && it->first == i) return it->second;
+        }
+        return tokenValue(source, kind(i), offsets[i], lengths[i]);
+    }
+
+    NumberValue number(size_t i) const {
+        auto it = lower_bound(numbers.begin(), numbers.end(), (uint32_t)i,
+                              [](const auto &entry, uint32_t index) { return entry.first < index; });
+        return it != numbers.end() && it->first == i ? it->second : NumberValue{};
+    }
+
+    Token operator[](size_t i) const {
+        return {kind(i), symbols[i], value(i), lines[i], columns[i], offsets[i], lengths[i], number(i)};
+    }
+
+    // Pulls the tokens in order, then the last one (END_OF_FILE) for good.
+    // Fields are read straight from the arrays, and the side lists are
+    // walked with cursors that only move forward, so unlike operator[] no
+    // token costs a search.
+    class Reader {
+    private:
+        const TokenBuffer &tokens;
+        const uint8_t *kinds;
+        const uint32_t *symbols, *offsets, *lengths;
+        const int32_t *lines, *columns;
+        size_t pos = 0, last, nextDecoded = 0, nextNumber = 0;
+
+    public:
+        explicit Reader(const TokenBuffer &tokens)
+            : tokens(tokens), kinds(tokens.kindArray.data()), symbols(tokens.symbols.data()),
+              offsets(tokens.offsets.data()), lengths(tokens.lengths.data()), lines(tokens.lines.data()),
+              columns(tokens.columns.data()), last(tokens.size() - 1) {}
+
+        Token nextToken() {
+            size_t i = pos < last ? pos++ : last;
+            TokenType type = (TokenType)kinds[i];
+            Token token{type, symbols[i], string_view(), lines[i], columns[i], offsets[i], lengths[i], NumberValue{}};
+            if (nextDecoded < tokens.decoded.size() && tokens.decoded[nextDecoded].first == i) {
+                token.value = tokens.decoded[nextDecoded++].second;
+            } else {
+                token.value = tokenValue(tokens.source, type, token.offset, token.length);
+            }
+            if (nextNumber < tokens.numbers.size() && tokens.numbers[nextNumber].first == i) {
+                token.number = tokens.numbers[nextNumber++].second;
+            }
+            return token;
+        }
+    };
+};
+
+// Symbol Table Class
+// Built by a pass over the token stream, after lexing: one entry per
+// declaration ("type identifier"), with the lines of every later reference
+// that resolves to it. Braces open and close scopes. Names used without a
+// visible declaration (cout, library functions) get one undeclared entry each.
+class SymbolTable {
+private:
+    static constexpr uint32_t NONE = 0xFFFFFFFFu;
+
+    // `type` and `scope` are views into the source or static text.
+    struct Symbol {
+        uint32_t name;  // Interned identifier
+        string_view type;
+        string_view scope;
+        int line;  // Declaration, or first use if undeclared
+        uint32_t firstUse = NONE, lastUse = NONE;
+    };
+
+    // Uses of all symbols share one vector, chained per symbol.
+    struct Use {
+        int line;
+        uint32_t next;
+    };
+
+    const Interner &interner;
+    ArenaVector<Symbol> symbols;
+    ArenaVector<Use> uses;
+    ScopedSymbolTable<uint32_t> declarations;  // Visible name -> index of its declaring entry
+    ArenaVector<uint32_t> undeclared;          // Name -> its undeclared entry, or NONE
+    deque<string> scopeNames;                  // "global", "block1", ... by depth
+
+    // The token before the one being observed
+    TokenType previousType = END_OF_FILE;
+    string_view previousValue;
+
+public:
+    // Entries and uses are allocated from `arena` when one is given.
+    explicit SymbolTable(const Interner &interner, Arena *arena = nullptr)
+        : interner(interner), symbols(arena), uses(arena), undeclared(arena), scopeNames{"global"} {}
+
+    void enterScope() {
+        declarations.enterScope();
+        while (scopeNames.size() <= declarations.depth()) {
+            scopeNames.push_back("block" + to_string(scopeNames.size()));
+        }
+    }
+
+    // Costs only the declarations made in the scope being left.
+    void exitScope() {
+        declarations.exitScope();
+    }
+
+    string_view currentScope() const {
+        return scopeNames[declarations.depth()];
+    }
+
+    // Type of the innermost visible declaration of `name`, or empty.
+    string_view typeOf(uint32_t name) const {
+        const uint32_t *entry = declarations.lookup(name);
+        return entry ? symbols[*entry].type : string_view();
+    }
+
+    size_t size() const {
+        return symbols.size();
+    }
+
+    // Feeds the pass the next token of the stream.
+    void observe(const Token &token) {
+        static constexpr auto dataTypes = [] {
+            array<bool, 256> table{};
+            for (TokenType type : {INT, FLOAT, DOUBLE, CHAR, STRING, VOID}) {
+                table[type] = true;
+            }
+            return table;
+        }();
+
+        if (token.type == LEFT_BRACE) {
+            enterScope();
+        } else if (token.type == RIGHT_BRACE) {
+            exitScope();
+        } else if (token.type == IDENTIFIER) {
+            if (dataTypes[previousType]) {
+                declare(token, previousValue);
+            } else {
+                use(token);
+            }
+        }
+        previousType = token.type;
+        previousValue = token.value;
+    }
+
+    void print(DumpWriter &out) const {
+        out << "\nSymbol Table:\n";
+        out.padded("Identifier", 15) << " | ";
+        out.padded("Type", 10) << " | ";
+        out.padded("Scope", 10) << " | ";
+        out.padded("Line", 5) << " | Uses\n";
+        for (int i = 0; i < 60; ++i) out << '-';
+        out << '\n';
+        for (const auto &symbol : symbols) {
+            out.padded(interner.name(symbol.name), 15) << " | ";
+            out.padded(symbol.type, 10) << " | ";
+            out.padded(symbol.scope, 10) << " | ";
+            out.padded(symbol.line, 5) << " |";
+            for (uint32_t use = symbol.firstUse; use != NONE; use = uses[use].next) {
+                out << ' ' << uses[use].line;
+            }
+            out << '\n';
+        }
+    }
+
+private:
+    // A redeclaration in the same scope gets its own entry and hides the
+    // earlier one from later uses.
+    void declare(const Token &identifier, string_view type) {
+        uint32_t entry = (uint32_t)symbols.size();
+        symbols.push_back({identifier.symbol, type, currentScope(), identifier.line});
+        if (!declarations.declare(identifier.symbol, entry)) {
+            *declarations.lookup(identifier.symbol) = entry;
+        }
+    }
+
+    void use(const Token &identifier) {
+        const uint32_t *declared = declarations.lookup(identifier.symbol);
+        if (declared) {
+            addUse(*declared, identifier.line);
+            return;
+        }
+        if (identifier.symbol >= undeclared.size()) {
+            undeclared.resize(max<size_t>(identifier.symbol + 1, undeclared.size() * 2), NONE);
+        }
+        uint32_t &entry = undeclared[identifier.symbol];
+        if (entry == NONE) {
+            entry = (uint32_t)symbols.size();
+            symbols.push_back({identifier.symbol, string_view(), scopeNames[0], identifier.line});
+        } else {
+            addUse(entry, identifier.line);
+        }
+    }
+
+    void addUse(uint32_t entry, int line) {
+        Symbol &symbol = symbols[entry];
+        uint32_t index = (uint32_t)uses.size();
+        uses.push_back({line, NONE});
+        if (symbol.lastUse == NONE) {
+            symbol.firstUse = index;
+        } else {
+            uses[symbol.lastUse].next = index;
+        }
+        symbol.lastUse = index;
+    }
+};
+
+// Lexer Class
+class Lexer {
+private:
+    string_view source;  // Not owned: the caller's string or a mapped file
+    size_t current, start;
+    size_t limit;        // No token starts at or after this offset
+    int line, column;
+    Arena ownLiterals;
+    Arena &literals;  // Decoded string literals: the caller's arena, or ownLiterals
+    string decoding;  // Literal being decoded, reused
+    Interner &interner;
+
+public:
+    Lexer(string_view src, Interner &interner, Arena *arena = nullptr)
+        : source(src), current(0), start(0), limit(src.length()), line(1), column(1),
+          literals(arena ? *arena : ownLiterals), interner(interner) {}
+
+    vector<Token> tokenize() {
+        vector<Token> tokens;
+        Token token;
+        while (next(token)) {
+            tokens.push_back(token);
+        }
+        tokens.push_back(endToken());
+        return tokens;
+    }
+
+    // Scans one token. Returns false once no token starts before the limit.
+    bool next(Token &token) {
+        do {
+            skipWhitespace();
+        } while (skipComment());
+        if (current >= limit) return false;
+
+        start = current;
+        char c = advance();
+
+        switch (c) {
+            case '+':
+                token = match('+') ? createToken(INCREMENT)
+                      : match('=') ? createToken(PLUS_ASSIGN)
+                                   : createToken(PLUS);
+                break;
+            case '-':
+                token = match('-') ? createToken(DECREMENT)
+                      : match('=') ? createToken(MINUS_ASSIGN)
+                      : match('>') ? createToken(MEMBER_ACCESS)
+                                   : createToken(MINUS);
+                break;
+            case '*': token = match('=') ? createToken(MULTIPLY_ASSIGN) : createToken(MULTIPLY); break;
+            case '/': token = match('=') ? createToken(DIVIDE_ASSIGN) : createToken(DIVIDE); break;
+            case '%': token = match('=') ? createToken(MODULO_ASSIGN) : createToken(MODULO); break;
+            case '=': token = match('=') ? createToken(EQUAL) : createToken(ASSIGN); break;
+            case '<':
+                token = match('=') ? createToken(LESS_EQUAL)
+                      : match('<') ? createToken(SHIFT_LEFT)
+                                   : createToken(LESS_THAN);
+                break;
+            case '>':
+                token = match('=') ? createToken(GREATER_EQUAL)
+                      : match('>') ? createToken(SHIFT_RIGHT)
+                                   : createToken(GREATER_THAN);
+                break;
+            case '!': token = match('=') ? createToken(NOT_EQUAL) : createToken(LOGICAL_NOT); break;
+            case '&': token = match('&') ? createToken(AND) : createToken(REFERENCE); break;
+            case '|': token = match('|') ? createToken(OR) : createToken(UNKNOWN); break;
+            case '(': token = createToken(LEFT_PAREN); break;
+            case ')': token = createToken(RIGHT_PAREN); break;
+            case '{': token = createToken(LEFT_BRACE); break;
+            case '}': token = createToken(RIGHT_BRACE); break;
+            case ';': token = createToken(SEMICOLON); break;
+            case ',': token = createToken(COMMA); break;
+            case '.': token = createToken(DOT); break;
+            case ':': token = createToken(COLON); break;
+            case '"': token = tokenizeStringLiteral(); break;
+            case '\'': token = tokenizeCharacterLiteral(); break;
+            default:
+                if (isdigit(c)) {
+                    token = tokenizeNumber();
+                } else if (isalpha(c) || c == '_') {
+                    token = tokenizeIdentifierOrKeyword();
+                } else {
+                    token = createToken(UNKNOWN);
+                }
+        }
+        return true;
+    }
+
+    // Pull interface for TokenStream: END_OF_FILE once the range is done.
+    Token nextToken() {
+        Token token;
+        return next(token) ? token : endToken();
+    }
+
+    Token endToken() const {
+        return {END_OF_FILE, NO_SYMBOL, string_view(), line, column, (uint32_t)current, 0, NumberValue{}};
+    }
+
+    // Restricts scanning to tokens that start in [begin, end). Whitespace is
+    // not skipped past `end`, but a token or comment starting before it may
+    // run on.
+    void setRange(size_t begin, size_t end) {
+        current = start = begin;
+        limit = end;
+    }
+
+    // Continues from `offset` as if the text before it had left the lexer at
+    // `line`/`column`, with no limit.
+    void resumeAt(size_t offset, int line, int column) {
+        setRange(offset, source.length());
+        this->line = line;
+        this->column = column;
+    }
+
+    int currentLine() const {
+        return line;
+    }
+
+    // Offset scanning stopped at: past the limit if a token or comment ran on.
+    size_t position() const {
+        return current;
+    }
+
+private:
+    bool isAtEnd() const {
+        return current >= source.length();
+    }
+
+    char advance() {
+        column++;
+        return source[current++];
+    }
+
+    // Skips a run of whitespace with the vectorised scanner and replays its
+    // effect on line/column: the column restarts after the last newline.
+    void skipWhitespace() {
+        if (current >= limit || !isspace(source[current])) return;
+
+        const char *begin = source.data() + current;
+        size_t newlines = 0;
+        const char *lastNewline = nullptr;
+        const char *stop = simd::skipWhitespace(begin, source.data() + limit, newlines, lastNewline);
+
+        if (newlines) {
+            line += (int)newlines;
+            column = 1 + (int)(stop - (lastNewline + 1));
+        } else {
+            column += (int)(stop - begin);
+        }
+        current = stop - source.data();
+    }
+
+    // `//` to the end of its line, or `/* ... */`; an unterminated block
+    // comment runs to the end of the input. False if none starts here.
+    bool skipComment() {
+        if (current >= limit || source[current] != '/' || current + 1 >= source.length()) return false;
+        const char *text = source.data(), *end = text + source.length();
+        size_t stop;
+        if (source[current + 1] == '/') {
+            stop = simd::findByte(text + current, end, '\n') - text;
+        } else if (source[current + 1] == '*') {
+            const char *close = text + current + 3;  // The '/' of "*/"; "/*/" does not close
+            while ((close = simd::findByte(min(close, end), end, '/')) != end && close[-1] != '*') ++close;
+            stop = close == end ? source.length() : close + 1 - text;
+        } else {
+            return false;
+        }
+        const char *lastNewline = nullptr;
+        if (size_t newlines = countNewlines(text + current, text + stop, lastNewline)) {
+            line += (int)newlines;
+            column = (int)(text + stop - lastNewline);
+        } else {
+            column += (int)(stop - current);
+        }
+        current = stop;
+        return true;
+    }
+
+    bool match(char expected) {
+        if (isAtEnd() || source[current] != expected) return false;
+        current++;
+        column++;
+        return true;
+    }
+
+    // View of the lexeme scanned since `start`.
+    string_view lexeme() const {
+        return source.substr(start, current - start);
+    }
+
+    Token createToken(TokenType type) {
+        return createToken(type, lexeme());
+    }
+
+    Token createToken(TokenType type, string_view value) {
+        return {type, NO_SYMBOL, value, line, column, (uint32_t)start, (uint32_t)(current - start), NumberValue{}};
+    }
+
+    // Scans and evaluates the literal in one pass; see common/number_literal.h.
+    Token tokenizeNumber() {
+        NumberLiteral literal;
+        const char *end = scanNumber(source.data() + start, source.data() + source.size(), literal);
+        size_t length = end - source.data() - start;
+        column += (int)(length - (current - start));
+        current = start + length;
+
+        Token token = createToken(literal.floating ? FLOAT_LITERAL : INTEGER_LITERAL);
+        token.number = numberValue(literal);
+        return token;
+    }
+
+    Token tokenizeIdentifierOrKeyword() {
+        while (!isAtEnd() && (isalnum(source[current]) || source[current] == '_')) {
+            advance();
+        }
+        string_view identifier = lexeme();
+
+        static constexpr auto keywords = makeKeywordTable<TokenType>({
+            {"if", IF}, {"else", ELSE},   {"while", WHILE}, {"for", FOR}, {"return", RETURN},
+            {"int", INT}, {"float", FLOAT}, {"double", DOUBLE},
+            {"char", CHAR}, {"string", STRING}, {"void", VOID},
+            {"break", BREAK}, {"continue", CONTINUE}, {"switch", SWITCH},
+            {"case", CASE}, {"default", DEFAULT}, {"public", PUBLIC},
+            {"private", PRIVATE}, {"protected", PROTECTED}, {"try", TRY},
+            {"catch", CATCH}, {"throw", THROW} ,{"struct", STRUCT } 
+        });
+
+        TokenType keyword = keywords.find(identifier, IDENTIFIER);
+        if (keyword != IDENTIFIER) {
+            return createToken(keyword);
+        } else {
+            Token token = createToken(IDENTIFIER);
+            token.symbol = interner.intern(identifier);
+            return token;
+        }
+        }
+
+    // Literals without escapes are returned as a view between the quotes. The
+    // vectorised scan jumps from one quote or backslash to the next; the first
+    // escape copies the literal so far into `decoding`, later plain runs are
+    // appended in bulk, and the result is stored in the literal arena.
+    Token tokenizeStringLiteral() {
+        const char *text = source.data();
+        size_t contentStart = current;
+        size_t run = current;  // Start of the plain run not yet in `decoding`
+        bool decoded = false;
+        while (true) {
+            size_t stop = simd::findEither(text + current, text + source.length(), '"', '\\') - text;
+            column += (int)(stop - current);
+            current = stop;
+            if (isAtEnd() || source[current] == '"') break;
+
+            if (current + 1 >= source.length()) {
+                advance();  // A backslash ending the input: unterminated
+                break;
+            }
+            // Handle escape characters
+            if (!decoded) {
+                decoding.assign(source, contentStart, current - contentStart);
+                decoded = true;
+            } else {
+                decoding.append(source, run, current - run);
+            }
+            advance();  // Skip the backslash
+            decoding += unescape(advance());
+            run = current;
+        }
+
+        if (isAtEnd()) {
+            // Handle unterminated string literal
+            return createToken(UNKNOWN, string_view());
+        }
+
+        if (decoded) decoding.append(source, run, current - run);
+        string_view literal = decoded ? literals.store(decoding)
+                                      : source.substr(contentStart, current - contentStart);
+        advance();  // Skip the closing quote
+        return createToken(STRING_LITERAL, literal);
+    }
+
+    // 'c' or an escape such as '\n', on one line. The value is the text
+    // between the quotes and the number the character's code. A quote that
+    // does not open one is UNKNOWN.
+    Token tokenizeCharacterLiteral() {
+        size_t width = !isAtEnd() && source[current] == '\\' ? 2 : 1;
+        if (current + width >= source.length() || source[current + width] != '\'' || source[current] == '\'' ||
+            source[current + width - 1] == '\n') {
+            return createToken(UNKNOWN);
+        }
+        char c = width == 2 ? unescape(source[current + 1]) : source[current];
+        current += width + 1;
+        column += (int)width + 1;
+        Token token = createToken(CHAR_LITERAL, source.substr(start + 1, width));
+        token.number.integer = (unsigned char)c;
+        return token;
+    }
+};
+
+// Lexes a large source on several threads. The source is cut at newlines and
+// every chunk is lexed on its own, assuming it starts at line 1, column 1 and
+// outside any token or comment. That only fails when a string literal or a
+// block comment spans a cut: the stitch step then relexes serially from the end
+// of the last token before it until a token lines up with the chunk's own
+// tokens again, and keeps the rest with its lines shifted. Each chunk interns
+// into its own Interner; ids are remapped in stream order, so tokens and ids
+// match Lexer::tokenize exactly.
+class ParallelLexer {
+private:
+    struct Chunk {
+        size_t begin, end;
+        unique_ptr<Interner> names;  // Chunk-local ids
+        unique_ptr<Lexer> lexer;     // Owns the literal pool the tokens point into
+        vector<Token> tokens;        // Chunk-relative lines, local ids
+        int endLine = 1;
+        size_t scanEnd = 0;          // Past `end` if a literal or comment ran on
+
+        // Filled in by stitch()
+        vector<Token> relexed;  // Replace tokens[0, firstKept)
+        size_t firstKept = 0;
+        int lineShift = 0;
+        vector<uint32_t> remap;  // Local id -> global id
+        size_t outputStart = 0;
+
+        size_t outputSize() const {
+            return relexed.size() + tokens.size() - firstKept;
+        }
+    };
+
+    string_view source;
+    Interner &interner;
+    size_t threads;
+    size_t minChunkBytes;
+    vector<Chunk> chunks;
+    unique_ptr<Lexer> relexer;
+    Token last{};  // Last token of the stitched stream so far
+    bool hasLast = false;
+
+public:
+    ParallelLexer(string_view src, Interner &interner, size_t threads, size_t minChunkBytes = 1 << 20)
+        : source(src), interner(interner), threads(max<size_t>(threads, 1)), minChunkBytes(max<size_t>(minChunkBytes, 1)) {}
+
+    vector<Token> tokenize() {
+        split();
+        ThreadPool pool(min(threads, chunks.size()));
+        pool.parallelFor(chunks.size(), [&](size_t i) { lexChunk(chunks[i]); });
+
+        Token endToken = stitch();
+
+        size_t total = 0;
+        for (Chunk &chunk : chunks) {
+            chunk.outputStart = total;
+            total += chunk.outputSize();
+        }
+        vector<Token> tokens(total + 1);
+        pool.parallelFor(chunks.size(), [&](size_t i) { emit(chunks[i], tokens); });
+        tokens[total] = endToken;
+
+        return tokens;
+    }
+
+private:
+    // A few chunks per thread, so one slow chunk doesn't hold up the rest.
+    void split() {
+        chunks.clear();
+        size_t count = max<size_t>(1, min(threads * 4, source.size() / minChunkBytes));
+        const char *begin = source.data(), *end = begin + source.size();
+        size_t cut = 0;
+        for (size_t i = 1; i <= count; ++i) {
+            size_t next = source.size();
+            if (i < count) {
+                size_t target = max(cut, source.size() / count * i);
+                next = simd::findByte(begin + target, end, '\n') - begin;
+                if (next < source.size()) next++;
+            }
+            if (next <= cut) continue;
+            Chunk chunk;
+            chunk.begin = cut;
+            chunk.end = next;
+            chunks.push_back(move(chunk));
+            cut = next;
+        }
+    }
+
+    void lexChunk(Chunk &chunk) {
+        chunk.names = make_unique<Interner>();
+        chunk.lexer = make_unique<Lexer>(source, *chunk.names);
+        chunk.lexer->setRange(chunk.begin, chunk.end);
+        Token token;
+        while (chunk.lexer->next(token)) {
+            chunk.tokens.push_back(token);
+        }
+        chunk.endLine = chunk.lexer->currentLine();
+        chunk.scanEnd = chunk.lexer->position();
+    }
+
+    // Serial pass over the chunks in order: decides which speculative tokens
+    // survive, relexes around literals that span cuts and assigns global ids.
+    // Returns the END_OF_FILE token.
+    Token stitch() {
+        relexer = make_unique<Lexer>(source, interner);
+        bool relexing = false;
+        Token pending{};
+        bool hasPending = false;
+        int boundaryLine = 1;  // Line at the current cut, while not relexing
+        size_t scanned = 0;    // Where the previous chunk's scan stopped
+        last = Token{};
+        hasLast = false;
+
+        for (Chunk &chunk : chunks) {
+            if (!relexing && scanned > chunk.begin) {
+                if (hasLast) {
+                    relexer->resumeAt(last.offset + last.length, last.line, last.column);
+                } else {
+                    relexer->resumeAt(0, 1, 1);
+                }
+                relexing = true;
+            }
+
+            if (!relexing) {
+                chunk.firstKept = 0;
+                chunk.lineShift = boundaryLine - 1;
+            } else {
+                size_t j = 0;
+                while (true) {
+                    if (!hasPending && !(hasPending = relexer->next(pending))) break;
+                    if (pending.offset >= chunk.end) break;
+                    while (j < chunk.tokens.size() && chunk.tokens[j].offset < pending.offset) j++;
+                    if (j < chunk.tokens.size() && chunk.tokens[j].offset == pending.offset &&
+                        chunk.tokens[j].column == pending.column) {
+                        // Back in step: the chunk's own tokens are right from here on.
+                        chunk.lineShift = pending.line - chunk.tokens[j].line;
+                        hasPending = false;
+                        relexing = false;
+                        break;
+                    }
+                    chunk.relexed.push_back(pending);
+                    last = pending;
+                    hasLast = true;
+                    hasPending = false;
+                }
+                chunk.firstKept = relexing ? chunk.tokens.size() : j;
+            }
+
+            remapNames(chunk);
+            if (chunk.firstKept < chunk.tokens.size()) {
+                last = chunk.tokens.back();
+                last.line += chunk.lineShift;
+                hasLast = true;
+            }
+            boundaryLine = chunk.endLine + chunk.lineShift;
+            scanned = relexing ? relexer->position() : chunk.scanEnd;
+        }
+
+        if (relexing || chunks.empty()) return relexer->endToken();
+        Token endToken = chunks.back().lexer->endToken();
+        endToken.line += chunks.back().lineShift;
+        return endToken;
+    }
+
+    // Global ids must be handed out in order of first appearance in the
+    // stitched stream. A fully kept chunk's local ids already are in that
+    // order; otherwise walk the kept tokens.
+    void remapNames(Chunk &chunk) {
+        chunk.remap.assign(chunk.names->size(), NO_SYMBOL);
+        if (chunk.firstKept == 0) {
+            for (uint32_t id = 0; id < chunk.remap.size(); ++id) {
+                chunk.remap[id] = interner.intern(chunk.names->name(id));
+            }
+            return;
+        }
+        for (size_t i = chunk.firstKept; i < chunk.tokens.size(); ++i) {
+            uint32_t symbol = chunk.tokens[i].symbol;
+            if (symbol != NO_SYMBOL && chunk.remap[symbol] == NO_SYMBOL) {
+                chunk.remap[symbol] = interner.intern(chunk.names->name(symbol));
+            }
+        }
+    }
+
+    void emit(const Chunk &chunk, vector<Token> &tokens) {
+        Token *out = tokens.data() + chunk.outputStart;
+        for (const Token &token : chunk.relexed) {
+            *out++ = token;
+        }
+        for (size_t i = chunk.firstKept; i < chunk.tokens.size(); ++i) {
+            Token token = chunk.tokens[i];
+            token.line += chunk.lineShift;
+            if (token.symbol != NO_SYMBOL) token.symbol = chunk.remap[token.symbol];
+            *out++ = token;
+        }
+    }
+};
+
+// A text edit: `removed` bytes at `offset` are replaced by `inserted`.
+struct TextEdit {
+    size_t offset;
+    size_t removed;
+    string_view inserted;
+};
+
+// Keeps an editor buffer and its tokens in step across edits. An edit relexes
+// from the end of the last token it cannot have touched until a new token
+// starts where an old one (from past the edit) now starts, at the same column;
+// from there the lexer state is the same as before, so the old tokens are kept
+// and only their offsets and lines move.
+//
+// That move is applied lazily: one pending shift covers a suffix of the token
+// list, and each edit only rewrites the tokens between its own position and
+// the previous edit's, so typing costs work proportional to the distance
+// between edits rather than to the size of the file.
+//
+// Token values are rebuilt from the buffer on access: views taken into the
+// buffer would not survive an edit.
+class IncrementalLexer {
+public:
+    // Token indices touched by an edit: `removed` old tokens starting at
+    // `first` were replaced by `inserted` new ones.
+    struct Change {
+        size_t first;
+        size_t removed;
+        size_t inserted;
+    };
+
+    explicit IncrementalLexer(Interner &interner) : interner(interner) {}
+
+    void reset(string_view source) {
+        buffer.assign(source);
+        literalPool.clear();
+        tokens.clear();
+        shiftFrom = 0;
+        offsetShift = lineShift = 0;
+
+        Lexer lexer(buffer, interner);
+        Token token;
+        while (lexer.next(token)) tokens.push_back(stored(token));
+        tokens.push_back(lexer.endToken());
+    }
+
+    Change applyEdit(const TextEdit &edit) {
+        if (edit.offset > buffer.size() || edit.removed > buffer.size() - edit.offset) {
+            throw out_of_range("edit outside the buffer");
+        }
+        buffer.replace(edit.offset, edit.removed, edit.inserted);
+        long delta = (long)edit.inserted.size() - (long)edit.removed;
+        size_t editEnd = edit.offset + edit.removed;  // Old coordinates
+
+        // First token whose end reaches the edit: it may grow, shrink or merge
+        // with the text after it. Everything before it is untouched.
+        size_t first = lowerBound(edit.offset);
+        Lexer lexer(buffer, interner);
+        if (first > 0) {
+            Token before = position(first - 1);
+            lexer.resumeAt(before.offset + before.length, before.line, before.column);
+        }
+
+        vector<Token> fresh;
+        size_t old = first;
+        size_t last = tokens.size() - 1;  // END_OF_FILE
+        bool synced = false;
+        int lineDelta = 0;
+        Token scanned;
+        while (lexer.next(scanned)) {
+            while (old < last && !reusable(old, editEnd, delta, scanned.offset)) old++;
+            if (old < last) {
+                Token candidate = position(old);
+                if (candidate.offset + delta == scanned.offset && candidate.column == scanned.column) {
+                    lineDelta = scanned.line - candidate.line;
+                    synced = true;
+                    break;
+                }
+            }
+            fresh.push_back(stored(scanned));
+        }
+        if (!synced) {
+            old = last + 1;
+            fresh.push_back(lexer.endToken());
+        }
+
+        splice(first, old, fresh, delta, lineDelta);
+        return {first, old - first, fresh.size()};
+    }
+
+    string_view text() const {
+        return buffer;
+    }
+
+    size_t size() const {
+        return tokens.size();
+    }
+
+    // Decoded literals held, one per token whose value needed decoding.
+    size_t literalCount() const {
+        return literalPool.size();
+    }
+
+    // The i-th token with its pending shift applied and its value rebuilt.
+    Token token(size_t i) const {
+        Token t = position(i);
+        if (t.value.data() == nullptr) t.value = tokenValue(buffer, t.type, t.offset, t.length);
+        return t;
+    }
+
+    vector<Token> allTokens() const {
+        vector<Token> result;
+        result.reserve(tokens.size());
+        for (size_t i = 0; i < tokens.size(); ++i) result.push_back(token(i));
+        return result;
+    }
+
+private:
+    Interner &interner;
+    string buffer;
+    // Decoded literals (not in the buffer), by the address the token's value
+    // points to; freed with the token that holds them.
+    unordered_map<const char *, unique_ptr<string>> literalPool;
+    vector<Token> tokens;  // Values cleared unless decoded; see token()
+
+    // tokens[shiftFrom..] are stored before a pending move of
+    // offsetShift/lineShift.
+    size_t shiftFrom = 0;
+    long offsetShift = 0;
+    int lineShift = 0;
+
+    // Keeps a decoded literal alive past the Lexer that made it, and drops
+    // every other value, which would point into the buffer.
+    Token stored(Token token) {
+        const char *begin = buffer.data(), *end = begin + buffer.size();
+        if (token.value.data() && (token.value.data() < begin || token.value.data() > end)) {
+            auto literal = make_unique<string>(token.value);
+            token.value = *literal;
+            literalPool.emplace(token.value.data(), move(literal));
+        } else {
+            token.value = string_view();
+        }
+        return token;
+    }
+
+    // The i-th token with its pending shift applied but its value left as
+    // stored; safe to call while the buffer is ahead of the tokens.
+    Token position(size_t i) const {
+        Token t = tokens[i];
+        if (i >= shiftFrom) {
+            t.offset += offsetShift;
+            t.line += lineShift;
+        }
+        return t;
+    }
+
+    // First token whose end is at or after `offset`; never past END_OF_FILE.
+    size_t lowerBound(size_t offset) const {
+        size_t low = 0, high = tokens.size() - 1;
+        while (low < high) {
+            size_t mid = (low + high) / 2;
+            Token t = position(mid);
+            if (t.offset + t.length < offset) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        return low;
+    }
+
+    // Old token `i` can only be reused if it starts past the edit (so its text
+    // is unchanged) and not before the token just lexed.
+    bool reusable(size_t i, size_t editEnd, long delta, size_t newOffset) const {
+        size_t offset = position(i).offset;
+        return offset >= editEnd && (long)offset + delta >= (long)newOffset;
+    }
+
+    void addShift(size_t from, size_t to, long offsetDelta, int lineDelta) {
+        for (size_t i = from; i < to; ++i) {
+            tokens[i].offset += offsetDelta;
+            tokens[i].line += lineDelta;
+        }
+    }
+
+    // Replaces old tokens [first, old) by `fresh` (already in new positions)
+    // and moves everything after them by delta/lineDelta.
+    void splice(size_t first, size_t old, const vector<Token> &fresh, long delta, int lineDelta) {
+        // The new tail shift lands on the old tail, which may already carry a
+        // pending shift from an earlier edit starting at shiftFrom. Make the
+        // stored tokens agree on one suffix shift again, rewriting whichever
+        // side of shiftFrom is shorter.
+        if (offsetShift == 0 && lineShift == 0) {
+            shiftFrom = old;
+        } else if (shiftFrom <= first) {
+            addShift(shiftFrom, first, offsetShift, lineShift);
+            shiftFrom = old;
+        } else if (shiftFrom < old) {
+            shiftFrom = old;
+        } else if (shiftFrom - old <= tokens.size() - shiftFrom) {
+            addShift(old, shiftFrom, -offsetShift, -lineShift);
+            shiftFrom = old;
+        } else {
+            addShift(shiftFrom, tokens.size(), offsetShift, lineShift);
+            offsetShift = lineShift = 0;
+            shiftFrom = old;
+        }
+        offsetShift += delta;
+        lineShift += lineDelta;
+
+        for (size_t i = first; i < old; ++i) {
+            if (tokens[i].value.data()) literalPool.erase(tokens[i].value.data());
+        }
+        long grow = (long)fresh.size() - (long)(old - first);
+        if (grow > 0) {
+            tokens.insert(tokens.begin() + old, grow, Token{});
+        } else if (grow < 0) {
+            tokens.erase(tokens.begin() + first + fresh.size(), tokens.begin() + old);
+        }
+        copy(fresh.begin(), fresh.end(), tokens.begin() + first);
+        shiftFrom += grow;
+    }
+};
+
+
+#include "lexer_tables.h"
+
+// Table-driven lexer. The tables are generated from tokens.l by
+// "Lexer Generator/dfagen.cpp"; the inner loop is one byte-class and one
+// transition lookup per byte, with longest-match backtracking to the last
+// accepting state. It produces the same tokens as Lexer::tokenize but leaves
+// symbol collection to the caller.
+//
+// Most of the time of either lexer goes into writing the Token vector, so
+// this one sizes the vector up front instead of letting it grow: every
+// reallocation copies all the tokens made so far into fresh memory.
+class DfaLexer {
+private:
+    string_view source;
+    Arena ownLiterals;
+    Arena &literals;  // Decoded string literals, as in Lexer
+    Interner &interner;
+
+public:
+    DfaLexer(string_view src, Interner &interner, Arena *arena = nullptr)
+        : source(src), literals(arena ? *arena : ownLiterals), interner(interner) {}
+
+    vector<Token> tokenize() {
+        vector<Token> tokens;
+        tokens.reserve(expectedTokens());
+        const char *begin = source.data();
+        const char *end = begin + source.size();
+        const char *p = begin;
+        const char *lineStart = begin;
+        int line = 1;
+
+        while (true) {
+            if (p < end && isspace(*p)) {
+                size_t newlines = 0;
+                const char *lastNewline = nullptr;
+                p = simd::skipWhitespace(p, end, newlines, lastNewline);
+                if (newlines) {
+                    line += (int)newlines;
+                    lineStart = lastNewline + 1;
+                }
+            }
+            if (p >= end) break;
+
+            const char *tokenStart = p;
+            p = commentEnd(p, end);
+            int accepted = DFA_SKIP;
+            if (p == tokenStart) {
+                uint32_t accepting;
+                p = longestMatch(p, end, accepting);
+                accepted = dfaAccept[accepting / DFA_CLASS_COUNT];
+            }
+
+            if (accepted == DFA_SKIP) {  // A comment: whitespace was skipped above
+                const char *lastNewline = nullptr;
+                if (size_t newlines = countNewlines(tokenStart, p, lastNewline)) {
+                    line += (int)newlines;
+                    lineStart = lastNewline + 1;
+                }
+                continue;
+            }
+
+            TokenType type = (TokenType)accepted;
+            string_view lexeme(tokenStart, p - tokenStart);
+            string_view value = lexeme;
+            if (type == STRING_LITERAL) {
+                value = decodeStringLiteral(lexeme.substr(1, lexeme.size() - 2));
+            } else if (type == CHAR_LITERAL) {
+                value = lexeme.substr(1, lexeme.size() - 2);
+            } else if (type == UNKNOWN && lexeme[0] == '"') {
+                value = string_view();  // Unterminated string literal
+            }
+
+            uint32_t symbol = type == IDENTIFIER ? interner.intern(lexeme) : NO_SYMBOL;
+            tokens.push_back({type, symbol, value, line, (int)(p - lineStart) + 1,
+                              (uint32_t)(tokenStart - begin), (uint32_t)lexeme.size(), NumberValue{}});
+            if (type == INTEGER_LITERAL || type == FLOAT_LITERAL) {
+                // The DFA has matched the literal; this only evaluates it.
+                NumberLiteral literal;
+                scanNumber(tokenStart, p, literal);
+                tokens.back().number = numberValue(literal);
+            } else if (type == CHAR_LITERAL) {
+                tokens.back().number.integer = (unsigned char)(value.size() == 2 ? unescape(value[1]) : value[0]);
+            }
+        }
+
+        tokens.push_back({END_OF_FILE, NO_SYMBOL, string_view(), line, (int)(p - lineStart) + 1,
+                          (uint32_t)source.size(), 0, NumberValue{}});
+        return tokens;
+    }
+
+private:
+    // End of the longest lexeme at `p`, at least one byte long as the
+    // catch-all rule matches any byte; `accepting` is its final state's row.
+    static const char *longestMatch(const char *p, const char *end, uint32_t &accepting) {
+        const char *acceptEnd = p;
+        uint32_t state = DFA_START;
+        accepting = 0;
+        while (p < end) {
+            state = dfaTransitions[state + dfaCharClass[(unsigned char)*p]];
+            if (state < DFA_FIRST_ACCEPTING) {
+                if (state == 0) break;
+                ++p;
+            } else {
+                accepting = state;
+                acceptEnd = ++p;
+            }
+        }
+        return acceptEnd;
+    }
+
+    // End of the comment at `p`, or `p` if none starts there. Comments are
+    // skipped with the vectorised scanner, as whitespace is, instead of a
+    // byte at a time through the DFA; they end where tokens.l says.
+    static const char *commentEnd(const char *p, const char *end) {
+        if (end - p < 2 || p[0] != '/') return p;
+        if (p[1] == '/') return simd::findByte(p, end, '\n');
+        if (p[1] != '*') return p;
+        const char *close = p + 3;  // The '/' of "*/"; "/*/" does not close
+        while ((close = simd::findByte(min(close, end), end, '/')) != end && close[-1] != '*') ++close;
+        return close == end ? end : close + 1;
+    }
+
+    // Tokens in the first 64 KB, scaled to the whole source, plus an eighth
+    // for a denser rest. Comments count as tokens here, so code is rarely
+    // short; if it is, the vector grows once.
+    size_t expectedTokens() const {
+        size_t sample = min<size_t>(source.size(), 64 << 10);
+        const char *p = source.data(), *end = p + sample;
+        size_t count = 0;
+        while (true) {
+            size_t newlines = 0;
+            const char *lastNewline = nullptr;
+            p = simd::skipWhitespace(p, end, newlines, lastNewline);
+            if (p >= end) break;
+            uint32_t accepting;
+            p = longestMatch(p, end, accepting);
+            count++;
+        }
+        size_t expected = sample ? count * (source.size() / sample) + count * (source.size() % sample) / sample : 0;
+        return expected + expected / 8 + 1;
+    }
+
+    string_view decodeStringLiteral(string_view raw) {
+        size_t backslash = raw.find('\\');
+        if (backslash == string_view::npos) return raw;
+
+        // Decoding only shrinks the text, so the raw length is enough room.
+        // Plain runs between escapes are copied whole.
+        char *decoded = (char *)literals.allocate(raw.size(), 1);
+        memcpy(decoded, raw.data(), backslash);
+        const char *p = raw.data() + backslash, *end = raw.data() + raw.size();
+        size_t length = backslash;
+        while (p < end) {
+            const char *escape = simd::findByte(p, end, '\\');
+            memcpy(decoded + length, p, escape - p);
+            length += escape - p;
+            if (escape == end) break;
+            decoded[length++] = unescape(escape[1]);  // The DFA only accepts complete escapes
+            p = escape + 2;
+        }
+        return string_view(decoded, length);
+    }
+};
+
+
+// Records every token pulled through it into the token cache format (see
+// common/token_cache.h), END_OF_FILE included. Names get cache-local ids in
+// order of first appearance.
+template <typename Source>
+class TokenCacheRecorder {
+private:
+    Source &source;
+    string_view sourceText;
+    const Interner &interner;
+    TokenCacheData data;
+    vector<uint32_t> localIds;  // Interner id -> cache-local id
+    string names;               // Cached names, laid out before `decoded`
+    string decoded;             // Decoded literal values
+    bool ended = false;
+
+public:
+    TokenCacheRecorder(Source &source, string_view sourceText, const Interner &interner)
+        : source(source), sourceText(sourceText), interner(interner) {}
+
+    Token nextToken() {
+        Token token = source.nextToken();
+        if (!ended) {
+            record(token);
+            ended = token.type == END_OF_FILE;
+        }
+        return token;
+    }
+
+    // Writes the cache file. Call once, after the stream has returned
+    // END_OF_FILE; a recording of a partial stream is not written.
+    bool write(const string &path) {
+        if (!ended) return false;
+        data.strings = names + decoded;
+        for (TokenCacheDecoded &entry : data.decoded) entry.begin += (uint32_t)names.size();
+        return writeTokenCache(path, sourceText, data);
+    }
+
+private:
+    void record(const Token &token) {
+        uint32_t index = (uint32_t)data.kinds.size();
+        data.kinds.push_back((uint8_t)token.type);
+        data.symbols.push_back(token.symbol == NO_SYMBOL ? TokenCacheData::NO_NAME : localId(token.symbol));
+        data.offsets.push_back(token.offset);
+        data.lengths.push_back(token.length);
+
+        uint32_t bias = token.offset + token.length - (uint32_t)token.column;
+        if (data.lines.empty() || data.lines.back().line != token.line || data.lines.back().bias != bias) {
+            data.lines.push_back({index, token.line, bias});
+        }
+        if (hasNumber(token.type)) {
+            uint64_t bits;
+            memcpy(&bits, &token.number, sizeof(bits));
+            data.numbers.push_back(bits);
+        }
+        if (token.value != tokenValue(sourceText, token.type, token.offset, token.length)) {
+            data.decoded.push_back({index, (uint32_t)decoded.size(), (uint32_t)token.value.size()});
+            decoded += token.value;
+        }
+    }
+
+    uint32_t localId(uint32_t symbol) {
+        if (symbol >= localIds.size()) localIds.resize(symbol + 1, TokenCacheData::NO_NAME);
+        if (localIds[symbol] == TokenCacheData::NO_NAME) {
+            localIds[symbol] = (uint32_t)data.nameEnds.size();
+            names += interner.name(symbol);
+            data.nameEnds.push_back((uint32_t)names.size());
+        }
+        return localIds[symbol];
+    }
+};
+
+// Token source over a mapped token cache: the same tokens, lines and values
+// the lexer produced for `source`, without lexing it. Cached names are
+// interned up front, so identifiers carry ids of the caller's interner.
+class CachedTokens {
+private:
+    const TokenCacheFile &cache;
+    string_view source;
+    TokenCacheReader reader;
+    const TokenCacheDecoded *decoded;
+    vector<uint32_t> ids;  // Cache-local name id -> interner id
+    uint32_t count, nextDecoded = 0;
+    Token last{};  // Returned again once END_OF_FILE is reached
+
+public:
+    CachedTokens(const TokenCacheFile &cache, string_view source, Interner &interner)
+        : cache(cache), source(source), reader(cache), decoded(cache.decoded()), count(cache.info().tokenCount) {
+        ids.reserve(cache.info().nameCount);
+        for (uint32_t id = 0; id < cache.info().nameCount; ++id) ids.push_back(interner.intern(cache.name(id)));
+    }
+
+    // The last cached token is END_OF_FILE; it is repeated once reached.
+    Token nextToken() {
+        if (!reader.next()) return last;
+        TokenType type = (TokenType)reader.kind;
+        uint32_t i = reader.index;
+        Token token{type, reader.symbol == TokenCacheData::NO_NAME ? NO_SYMBOL : ids[reader.symbol], string_view(),
+                    reader.line, reader.column, reader.offset, reader.length, NumberValue{}};
+        if (nextDecoded < cache.info().decodedCount && decoded[nextDecoded].token == i) {
+            token.value = cache.value(decoded[nextDecoded++]);
+        } else {
+            token.value = tokenValue(source, type, reader.offset, reader.length);
+        }
+        if (hasNumber(type)) token.number.integer = reader.number();
+        last = token;
+        return token;
+    }
+
+    vector<Token> tokenize() {
+        vector<Token> tokens;
+        tokens.reserve(count);
+        for (uint32_t i = 0; i < count; ++i) tokens.push_back(nextToken());
+        return tokens;
+    }
+};
+
+
+// Three-address code works on operands instead of strings: names (identifiers
+// and other spellings) are interned ids, temporaries and labels are numbers,
+// and numeric literals are the values the lexer computed, so later phases
+// compare integers and only build text when printing.
+enum OperandKind : uint8_t {
+    OPERAND_NONE,
+    OPERAND_NAME,
+    OPERAND_TEMP,
+    OPERAND_LABEL,
+    OPERAND_STRING,  // String literal: `id` is its interned value
+    OPERAND_INTEGER,
+    OPERAND_FLOAT,   // 'f' literal: `real` holds a float value
+    OPERAND_DOUBLE
+};
+
+struct Operand {
+    OperandKind kind;
+    union {
+        uint32_t id;
+        uint64_t integer;
+        double real;
+    };
+
+    static Operand integerConstant(uint64_t value) {
+        Operand operand = {OPERAND_INTEGER, 0};
+        operand.integer = value;
+        return operand;
+    }
+
+    static Operand realConstant(double value, bool singlePrecision) {
+        Operand operand = {singlePrecision ? OPERAND_FLOAT : OPERAND_DOUBLE, 0};
+        operand.real = value;
+        return operand;
+    }
+
+    bool empty() const {
+        return kind == OPERAND_NONE;
+    }
+
+    bool isConstant() const {
+        return kind == OPERAND_INTEGER || kind == OPERAND_FLOAT || kind == OPERAND_DOUBLE;
+    }
+
+    bool operator==(const Operand &other) const {
+        if (kind != other.kind) return false;
+        return isConstant() ? integer == other.integer : id == other.id;
+    }
+
+    // Writes the operand to an ostream or DumpWriter. Floating constants get
+    // the shortest text that reads back as the same value; strings are
+    // quoted, with their escapes put back.
+    template <typename Out>
+    void format(Out &out, const Interner &interner) const {
+        char text[32];
+        switch (kind) {
+            case OPERAND_NAME: out << interner.name(id); break;
+            case OPERAND_TEMP: out << "temp" << id; break;
+            case OPERAND_LABEL: out << "L" << id; break;
+            case OPERAND_STRING:
+                out << '"';
+                for (char c : interner.name(id)) {
+                    switch (c) {
+                        case '"': out << "\\\""; break;
+                        case '\\': out << "\\\\"; break;
+                        case '\n': out << "\\n"; break;
+                        case '\t': out << "\\t"; break;
+                        default: out << c; break;
+                    }
+                }
+                out << '"';
+                break;
+            case OPERAND_INTEGER: out << integer; break;
+            case OPERAND_FLOAT: out << string_view(text, to_chars(text, text + sizeof(text), (float)real).ptr - text); break;
+            case OPERAND_DOUBLE: out << string_view(text, to_chars(text, text + sizeof(text), real).ptr - text); break;
+            default: break;
+        }
+    }
+
+    string toString(const Interner &interner) const {
+        ostringstream out;
+        format(out, interner);
+        return out.str();
+    }
+};
+
+const Operand NO_OPERAND = {OPERAND_NONE, 0};
+
+// Operators of three-address code. The arithmetic, comparison and unary ones
+// are also the operators of syntax tree nodes; TAC_AND and TAC_OR only occur
+// there, as conditions are lowered to jumps.
+enum TacOp : uint8_t {
+    TAC_ASSIGN,    // result = arg1
+    TAC_ADD,       // result = arg1 op arg2, up to TAC_OR
+    TAC_SUB,
+    TAC_MUL,
+    TAC_DIV,
+    TAC_MOD,
+    TAC_SHL,
+    TAC_SHR,
+    TAC_EQ,
+    TAC_NE,
+    TAC_LT,
+    TAC_GT,
+    TAC_LE,
+    TAC_GE,
+    TAC_AND,
+    TAC_OR,
+    TAC_NEG,       // result = op arg1, up to TAC_DEREF
+    TAC_NOT,
+    TAC_ADDRESS,
+    TAC_DEREF,
+    TAC_STORE,     // *result = arg1
+    TAC_LABEL,     // result:
+    TAC_GOTO,      // goto result
+    TAC_IF,        // if arg1 goto result
+    TAC_IF_FALSE,  // ifFalse arg1 goto result
+    TAC_PARAM,     // param arg1
+    TAC_CALL,      // result = call arg1, arg2 (the argument count); result may be empty
+    TAC_RETURN,    // return arg1; arg1 may be empty
+    TAC_FUNCTION,  // function result
+    TAC_END        // end result
+};
+
+inline const char *tacOpSymbol(TacOp op) {
+    static const char *const symbols[] = {
+        "=", "+", "-", "*", "/", "%", "<<", ">>", "==", "!=", "<", ">", "<=", ">=", "&&", "||", "-", "!", "&", "*",
+        "*", ":", "goto", "if", "ifFalse", "param", "call", "return", "function", "end"
+    };
+    static_assert(sizeof(symbols) / sizeof(symbols[0]) == TAC_END + 1, "one symbol per TacOp");
+    return symbols[op];
+}
+
+// Syntax tree between parsing and code generation. Nodes live in one array
+// and point at each other by 32-bit index, so a whole tree is one growing
+// allocation from the compilation arena and a node is 32 bytes. Lists
+// (statements of a block, arguments of a call) are chained through `next`.
+enum SyntaxKind : uint8_t {
+    SYNTAX_PROGRAM,      // child[0]: first item
+    SYNTAX_FUNCTION,     // name; op: return type; child[0]: first parameter, child[1]: body, none for a prototype
+    SYNTAX_PARAMETER,    // name
+    SYNTAX_BLOCK,        // child[0]: first statement
+    SYNTAX_DECLARATION,  // op: type keyword, or IDENTIFIER with the type in name; child[0]: first variable
+    SYNTAX_VARIABLE,     // name; child[0]: initializer, child[1]: first constructor argument
+    SYNTAX_EXPRESSION,   // child[0]: expression
+    SYNTAX_IF,           // child[0]: condition, child[1]: then, child[2]: else
+    SYNTAX_WHILE,        // child[0]: condition, child[1]: body
+    SYNTAX_FOR,          // child[0]: init, child[1]: condition, child[2]: body; extra: step
+    SYNTAX_SWITCH,       // child[0]: value, child[1]: body
+    SYNTAX_CASE,         // child[0]: value
+    SYNTAX_DEFAULT,
+    SYNTAX_BREAK,
+    SYNTAX_CONTINUE,
+    SYNTAX_RETURN,       // child[0]: value
+    SYNTAX_TRY,          // child[0]: body, child[1]: first catch
+    SYNTAX_CATCH,        // child[0]: parameter, child[1]: body
+    SYNTAX_THROW,        // child[0]: value
+    SYNTAX_STRUCT,       // name; child[0]: first member
+    SYNTAX_EMPTY,
+    SYNTAX_ERROR,        // Left where a syntax error was found
+    SYNTAX_NAME,         // name
+    SYNTAX_INTEGER,      // integer
+    SYNTAX_REAL,         // real; flags: SINGLE_PRECISION
+    SYNTAX_STRING,       // name: the interned value
+    SYNTAX_UNARY,        // op; child[0]: operand
+    SYNTAX_BINARY,       // op; child[0], child[1]: operands
+    SYNTAX_ASSIGN,       // op: TAC_ASSIGN, or the operator of "op="; child[0]: target, child[1]: value
+    SYNTAX_POSTFIX,      // op: TAC_ADD for x++, TAC_SUB for x--; child[0]: operand
+    SYNTAX_CALL,         // child[0]: callee, child[1]: first argument
+    SYNTAX_MEMBER        // name: the member; flags: ARROW; child[0]: object
+};
+
+inline const char *syntaxKindName(SyntaxKind kind) {
+    static const char *const names[] = {
+        "program", "function", "parameter", "block", "declaration", "variable", "expression", "if", "while", "for",
+        "switch", "case", "default", "break", "continue", "return", "try", "catch", "throw", "struct", "empty",
+        "error", "name", "integer", "real", "string", "unary", "binary", "assign", "postfix", "call", "member"
+    };
+    static_assert(sizeof(names) / sizeof(names[0]) == SYNTAX_MEMBER + 1, "one name per SyntaxKind");
+    return names[kind];
+}
+
+struct SyntaxNode {
+    static constexpr uint32_t NONE = 0xFFFFFFFFu;
+    static constexpr uint8_t SINGLE_PRECISION = 1;  // 'f' literal
+    static constexpr uint8_t ARROW = 1;             // p->member rather than p.member
+
+    SyntaxKind kind;
+    uint8_t op;  // TacOp of an operator, TokenType of a declared type
+    uint8_t flags;
+    int32_t line;
+    uint32_t child[3];
+    uint32_t next;  // Next node of the same list
+    union {
+        uint32_t name;  // Interned id
+        uint32_t extra;
+        uint64_t integer;
+        double real;
+    };
+};
+
+static_assert(sizeof(SyntaxNode) == 32, "syntax nodes are 32 bytes");
+
+class SyntaxTree {
+public:
+    explicit SyntaxTree(Arena *arena = nullptr) : nodes(arena) {}
+
+    uint32_t root = SyntaxNode::NONE;
+
+    // Appends a node with no children; references to nodes do not survive it.
+    uint32_t add(SyntaxKind kind, int line) {
+        SyntaxNode node{};
+        node.kind = kind;
+        node.line = line;
+        node.child[0] = node.child[1] = node.child[2] = node.next = SyntaxNode::NONE;
+        nodes.push_back(node);
+        return (uint32_t)nodes.size() - 1;
+    }
+
+    SyntaxNode &operator[](uint32_t i) {
+        return nodes[i];
+    }
+
+    const SyntaxNode &operator[](uint32_t i) const {
+        return nodes[i];
+    }
+
+    size_t size() const {
+        return nodes.size();
+    }
+
+    // New nodes are zero until written, by copyItems.
+    void resize(size_t n) {
+        nodes.resize(n);
+    }
+
+    // Copies another tree's nodes over this tree's from `at` on, renumbered,
+    // leaving out its program node (always its first), and returns where
+    // that program's first item landed (NONE if it has none). Copies to
+    // ranges that do not overlap may run at the same time.
+    uint32_t copyItems(const SyntaxTree &other, uint32_t at) {
+        uint32_t shift = at - 1;
+        auto moved = [&](uint32_t i) { return i == SyntaxNode::NONE ? i : i + shift; };
+        for (size_t i = 1; i < other.size(); ++i) {
+            SyntaxNode &node = nodes[i + shift];
+            node = other[i];
+            for (uint32_t &child : node.child) child = moved(child);
+            node.next = moved(node.next);
+            if (node.kind == SYNTAX_FOR) node.extra = moved(node.extra);
+        }
+        return moved(other[other.root].child[0]);
+    }
+
+    // One node per line, children indented under their parent. Walks with a
+    // stack of pending lists rather than by recursion, so any depth prints.
+    template <typename Out>
+    void format(Out &out, const Interner &interner) const {
+        vector<pair<uint32_t, int>> pending;  // First node of a list still to print, and its depth
+        if (root != SyntaxNode::NONE) pending.push_back({root, 0});
+        while (!pending.empty()) {
+            auto [i, depth] = pending.back();
+            pending.pop_back();
+            const SyntaxNode &node = nodes[i];
+            formatNode(out, interner, node, depth);
+            // Pushed in reverse: the children print first, in order, then the rest of the list.
+            if (node.next != SyntaxNode::NONE) pending.push_back({node.next, depth});
+            if (node.kind == SYNTAX_FOR && node.extra != SyntaxNode::NONE) pending.push_back({node.extra, depth + 1});
+            for (int c = 2; c >= 0; --c) {
+                if (node.child[c] != SyntaxNode::NONE) pending.push_back({node.child[c], depth + 1});
+            }
+        }
+    }
+
+private:
+    ArenaVector<SyntaxNode> nodes;
+
+    template <typename Out>
+    static void formatNode(Out &out, const Interner &interner, const SyntaxNode &node, int depth) {
+        for (int level = 0; level < depth; ++level) out << "  ";
+        out << syntaxKindName(node.kind);
+        switch (node.kind) {
+            case SYNTAX_FUNCTION:
+            case SYNTAX_PARAMETER:
+            case SYNTAX_VARIABLE:
+            case SYNTAX_NAME:
+                out << ' ' << interner.name(node.name);
+                break;
+            case SYNTAX_STRUCT:
+            case SYNTAX_MEMBER:
+                if (node.name != NO_SYMBOL) out << ' ' << interner.name(node.name);
+                break;
+            case SYNTAX_DECLARATION:
+                out << ' ' << (node.op == IDENTIFIER ? interner.name(node.name) : tokenTypeName((TokenType)node.op));
+                break;
+            case SYNTAX_INTEGER: out << ' ' << node.integer; break;
+            case SYNTAX_REAL:
+                out << ' ';
+                Operand::realConstant(node.real, node.flags & SyntaxNode::SINGLE_PRECISION).format(out, interner);
+                break;
+            case SYNTAX_STRING:
+                out << ' ';
+                Operand{OPERAND_STRING, node.name}.format(out, interner);
+                break;
+            case SYNTAX_UNARY:
+            case SYNTAX_BINARY:
+            case SYNTAX_ASSIGN:
+            case SYNTAX_POSTFIX:
+                out << ' ' << tacOpSymbol((TacOp)node.op);
+                break;
+            default: break;
+        }
+        out << '\n';
+    }
+};
+
+struct SyntaxError {
+    int line, column;
+    string message;
+};
+
+// How Parser nests. RECURSIVE_DESCENT makes one native call per rule, so
+// the native stack grows with the nesting depth of the input; EXPLICIT_STACK
+// keeps open blocks, statement bodies, operators and parentheses on heap
+// vectors instead and handles any depth. Both build the same tree and
+// report the same errors.
+enum ParseMode { RECURSIVE_DESCENT, EXPLICIT_STACK };
+
+// Recursive-descent parser from a TokenStream (lookahead of at least 4) to a
+// SyntaxTree, with precedence climbing for binary operators. A character
+// literal is the integer constant of its code: 'A' is 65. A syntax error is recorded, leaves a SYNTAX_ERROR node, and the rest of
+// the statement is skipped.
+template <typename Stream>
+class Parser {
+public:
+    Parser(Stream &tokens, Interner &interner, Arena *arena = nullptr, ParseMode mode = RECURSIVE_DESCENT)
+        : tokens(tokens), interner(interner), tree(arena), mode(mode) {}
+
+    // Parses up to END_OF_FILE. Call once.
+    SyntaxTree parse() {
+        uint32_t program = tree.add(SYNTAX_PROGRAM, peek().line);
+        uint32_t items = mode == EXPLICIT_STACK ? parseItemsWithFrames() : parseItems();
+        tree[program].child[0] = items;
+        tree.root = program;
+        return move(tree);
+    }
+
+    const vector<SyntaxError> &errors() const {
+        return errorList;
+    }
+
+    // Interns under `lock`, for parsers sharing an interner across threads.
+    void shareInterner(mutex &lock) {
+        internerLock = &lock;
+    }
+
+private:
+    static constexpr uint32_t NONE = SyntaxNode::NONE;
+
+    Stream &tokens;
+    Interner &interner;
+    mutex *internerLock = nullptr;
+    SyntaxTree tree;
+    ParseMode mode;
+    vector<SyntaxError> errorList;
+    size_t consumed = 0;
+    bool recovering = false;  // Errors are not reported again until the next statement
+
+    // Binary operator at the front of the stream and its precedence (higher
+    // binds tighter).
+    struct BinaryOperator {
+        TacOp op;
+        int precedence;
+        bool assignment;
+    };
+
+    const Token &peek(size_t k = 0) {
+        return tokens.peek(k);
+    }
+
+    Token advance() {
+        consumed++;
+        return tokens.nextToken();
+    }
+
+    bool check(TokenType type, size_t k = 0) {
+        return peek(k).type == type;
+    }
+
+    bool match(TokenType type) {
+        if (!check(type)) return false;
+        advance();
+        return true;
+    }
+
+    static bool isType(TokenType type) {
+        return type == INT || type == FLOAT || type == DOUBLE || type == CHAR || type == STRING || type == VOID;
+    }
+
+    uint32_t symbolOf(const Token &token) {
+        return token.symbol != NO_SYMBOL ? token.symbol : intern(token.value);
+    }
+
+    uint32_t intern(string_view text) {
+        if (!internerLock) return interner.intern(text);
+        lock_guard<mutex> lock(*internerLock);
+        return interner.intern(text);
+    }
+
+    static void appendPart(string &message, string_view text) {
+        message += text;
+    }
+
+    static void appendPart(string &message, const Token &token) {
+        if (token.type == END_OF_FILE) {
+            message += "end of input";
+            return;
+        }
+        message += '\'';
+        message += token.value;
+        message += '\'';
+    }
+
+    template <typename... Parts>
+    void error(const Token &at, const Parts &...parts) {
+        error(at.line, at.column, parts...);
+    }
+
+    // The message is the parts run together, tokens quoted. It is only built
+    // when the error is kept: none are while recovering from an earlier one.
+    template <typename... Parts>
+    void error(int line, int column, const Parts &...parts) {
+        if (recovering) return;
+        string message;
+        (appendPart(message, parts), ...);
+        errorList.push_back({line, column, move(message)});
+        recovering = true;
+    }
+
+    bool expect(TokenType type, const char *spelling) {
+        if (match(type)) return true;
+        error(peek(), "expected ", spelling, " before ", peek());
+        return false;
+    }
+
+    // Skips past the end of the statement: its ';', or the '}' closing a
+    // block it opened. Stops before a '}' that closes an enclosing block.
+    void synchronize() {
+        int depth = 0;
+        while (!check(END_OF_FILE)) {
+            if (depth == 0 && check(RIGHT_BRACE)) return;
+            TokenType type = advance().type;
+            if (type == LEFT_BRACE) {
+                depth++;
+            } else if (type == RIGHT_BRACE) {
+                if (--depth == 0) return;
+            } else if (type == SEMICOLON && depth == 0) {
+                return;
+            }
+        }
+    }
+
+    uint32_t endStatement(uint32_t node) {
+        if (!expect(SEMICOLON, "';'")) synchronize();
+        return node;
+    }
+
+    void append(uint32_t &first, uint32_t node) {
+        if (first == NONE) {
+            first = node;
+            return;
+        }
+        uint32_t last = first;
+        while (tree[last].next != NONE) last = tree[last].next;
+        tree[last].next = node;
+    }
+
+    void set(uint32_t node, uint32_t a, uint32_t b = NONE, uint32_t c = NONE) {
+        tree[node].child[0] = a;
+        tree[node].child[1] = b;
+        tree[node].child[2] = c;
+    }
+
+    // Items up to a '}' or END_OF_FILE, which is left in the stream.
+    template <typename ParseOne>
+    uint32_t parseList(ParseOne parseOne) {
+        uint32_t first = NONE, last = NONE;
+        while (!check(RIGHT_BRACE) && !check(END_OF_FILE)) {
+            recovering = false;
+            size_t before = consumed;
+            uint32_t item = parseOne();
+            if (item != NONE) {
+                if (first == NONE) {
+                    first = item;
+                } else {
+                    tree[last].next = item;
+                }
+                last = item;
+            }
+            if (consumed == before) advance();  // A token nothing can start with
+        }
+        return first;
+    }
+
+    // Top-level items: functions, declarations and structs.
+    uint32_t parseItems() {
+        auto item = [&]() -> uint32_t {
+            if (startsFunction()) return parseFunction();
+            if (startsGlobal()) return parseStatement();
+            int line = peek().line;
+            error(peek(), "expected a declaration before ", peek());
+            parseStatement();  // Skipped whole, braces and all
+            return tree.add(SYNTAX_ERROR, line);
+        };
+        uint32_t items = parseList(item);
+        while (!check(END_OF_FILE)) {  // Stopped at a '}' with no block open
+            recovering = false;
+            error(peek(), "unexpected ", peek());
+            advance();
+            uint32_t more = parseList(item);
+            append(items, more);
+        }
+        return items;
+    }
+
+    // What may stand outside a function, other than a function.
+    bool startsGlobal() {
+        return check(STRUCT) || check(SEMICOLON) || startsDeclaration();
+    }
+
+    // "type name (", with at most one '*' or '&' between.
+    bool startsFunction() {
+        if (!isType(peek().type) && !check(IDENTIFIER)) return false;
+        size_t k = check(MULTIPLY, 1) || check(REFERENCE, 1) ? 2 : 1;
+        return check(IDENTIFIER, k) && check(LEFT_PAREN, k + 1);
+    }
+
+    uint32_t parseFunction() {
+        return parseFunctionRest(parseFunctionHead());
+    }
+
+    // Return type and name.
+    uint32_t parseFunctionHead() {
+        TokenType type = advance().type;
+        while (match(MULTIPLY) || match(REFERENCE)) {}
+        Token name = advance();
+        uint32_t function = tree.add(SYNTAX_FUNCTION, name.line);
+        tree[function].op = type;
+        tree[function].name = symbolOf(name);
+        return function;
+    }
+
+    // Parameters and body of a function or constructor, after its name.
+    uint32_t parseFunctionRest(uint32_t function) {
+        if (parseSignature(function)) {
+            uint32_t body = parseBlock();
+            tree[function].child[1] = body;
+        }
+        return function;
+    }
+
+    // The parameter list; true if a body follows. Constructor initializer
+    // lists are skipped.
+    bool parseSignature(uint32_t function) {
+        expect(LEFT_PAREN, "'('");
+        uint32_t parameters = parseParameters();
+        tree[function].child[0] = parameters;
+        if (!expect(RIGHT_PAREN, "')'")) {
+            synchronize();
+            return false;
+        }
+        if (check(COLON)) {
+            while (!check(LEFT_BRACE) && !check(SEMICOLON) && !check(END_OF_FILE)) advance();
+        }
+        return !match(SEMICOLON);
+    }
+
+    uint32_t parseParameters() {
+        uint32_t first = NONE;
+        while (!check(RIGHT_PAREN) && !check(END_OF_FILE)) {
+            uint32_t parameter = parseParameter();
+            if (parameter != NONE) append(first, parameter);
+            if (!match(COMMA)) break;
+        }
+        return first;
+    }
+
+    // Type words, '*' and '&', then the name, which is the last identifier
+    // before ',' or ')': "const char* msg". NONE for an unnamed parameter.
+    uint32_t parseParameter() {
+        while (isType(peek().type) || check(IDENTIFIER) || check(MULTIPLY) || check(REFERENCE)) {
+            Token token = advance();
+            if (token.type == IDENTIFIER && (check(COMMA) || check(RIGHT_PAREN))) {
+                uint32_t parameter = tree.add(SYNTAX_PARAMETER, token.line);
+                tree[parameter].name = symbolOf(token);
+                return parameter;
+            }
+        }
+        return NONE;
+    }
+
+    uint32_t parseBlock() {
+        uint32_t block = tree.add(SYNTAX_BLOCK, peek().line);
+        if (!expect(LEFT_BRACE, "'{'")) return block;
+        uint32_t statements = parseList([&] { return parseStatement(); });
+        tree[block].child[0] = statements;
+        expect(RIGHT_BRACE, "'}'");
+        return block;
+    }
+
+    uint32_t parseStatement() {
+        switch (peek().type) {
+            case LEFT_BRACE: return parseBlock();
+            case IF: {
+                uint32_t node = parseIfHead();
+                uint32_t then = parseStatement();
+                tree[node].child[1] = then;
+                if (match(ELSE)) {
+                    uint32_t otherwise = parseStatement();
+                    tree[node].child[2] = otherwise;
+                }
+                return node;
+            }
+            case WHILE:
+            case SWITCH: {
+                uint32_t node = parseLoopHead();
+                uint32_t body = parseStatement();
+                tree[node].child[1] = body;
+                return node;
+            }
+            case FOR: {
+                uint32_t node = parseForHead();
+                uint32_t body = parseStatement();
+                tree[node].child[2] = body;
+                return node;
+            }
+            case TRY: return parseTry();
+            case STRUCT: return parseStruct();
+            default: return parseSimpleStatement();
+        }
+    }
+
+    // "if (condition)"; the branches are left to the caller.
+    uint32_t parseIfHead() {
+        uint32_t node = tree.add(SYNTAX_IF, advance().line);
+        uint32_t condition = parseCondition();
+        tree[node].child[0] = condition;
+        return node;
+    }
+
+    // "while (condition)" or "switch (value)", without the body.
+    uint32_t parseLoopHead() {
+        Token keyword = advance();
+        uint32_t node = tree.add(keyword.type == WHILE ? SYNTAX_WHILE : SYNTAX_SWITCH, keyword.line);
+        uint32_t condition = parseCondition();
+        tree[node].child[0] = condition;
+        return node;
+    }
+
+    // Statements with no statement inside them.
+    uint32_t parseSimpleStatement() {
+        int line = peek().line;
+        switch (peek().type) {
+            case CASE: {
+                advance();
+                uint32_t node = tree.add(SYNTAX_CASE, line);
+                uint32_t value = parseExpression();
+                set(node, value);
+                expect(COLON, "':'");
+                return node;
+            }
+            case DEFAULT:
+            case PUBLIC:
+            case PRIVATE:
+            case PROTECTED: {
+                bool isDefault = advance().type == DEFAULT;
+                expect(COLON, "':'");
+                return tree.add(isDefault ? SYNTAX_DEFAULT : SYNTAX_EMPTY, line);
+            }
+            case BREAK:
+            case CONTINUE: {
+                bool isBreak = advance().type == BREAK;
+                return endStatement(tree.add(isBreak ? SYNTAX_BREAK : SYNTAX_CONTINUE, line));
+            }
+            case RETURN: {
+                advance();
+                uint32_t node = tree.add(SYNTAX_RETURN, line);
+                uint32_t value = check(SEMICOLON) ? NONE : parseExpression();
+                set(node, value);
+                return endStatement(node);
+            }
+            case THROW: {
+                advance();
+                uint32_t node = tree.add(SYNTAX_THROW, line);
+                uint32_t value = parseExpression();
+                set(node, value);
+                return endStatement(node);
+            }
+            case SEMICOLON: advance(); return tree.add(SYNTAX_EMPTY, line);
+            default:
+                if (startsDeclaration()) return parseDeclaration();
+                return parseExpressionStatement();
+        }
+    }
+
+    uint32_t parseCondition() {
+        expect(LEFT_PAREN, "'('");
+        uint32_t condition = parseExpression();
+        expect(RIGHT_PAREN, "')'");
+        return condition;
+    }
+
+    // "for (init; condition; step)", without the body.
+    uint32_t parseForHead() {
+        uint32_t node = tree.add(SYNTAX_FOR, advance().line);
+        expect(LEFT_PAREN, "'('");
+        uint32_t init = NONE, condition = NONE, step = NONE;
+        if (!match(SEMICOLON)) init = startsDeclaration() ? parseDeclaration() : parseExpressionStatement();
+        if (!check(SEMICOLON)) condition = parseExpression();
+        expect(SEMICOLON, "';'");
+        if (!check(RIGHT_PAREN)) step = parseExpression();
+        expect(RIGHT_PAREN, "')'");
+        set(node, init, condition);
+        tree[node].extra = step;
+        return node;
+    }
+
+    uint32_t parseTry() {
+        uint32_t node = tree.add(SYNTAX_TRY, advance().line);
+        uint32_t body = parseBlock();
+        uint32_t handlers = NONE;
+        while (check(CATCH)) {
+            uint32_t handler = parseCatchHead();
+            uint32_t handlerBody = parseBlock();
+            tree[handler].child[1] = handlerBody;
+            append(handlers, handler);
+        }
+        set(node, body, handlers);
+        return node;
+    }
+
+    // "catch (parameter)", without the body.
+    uint32_t parseCatchHead() {
+        uint32_t handler = tree.add(SYNTAX_CATCH, advance().line);
+        expect(LEFT_PAREN, "'('");
+        uint32_t parameter = parseParameter();
+        while (!check(RIGHT_PAREN) && !check(LEFT_BRACE) && !check(END_OF_FILE)) advance();  // catch (...)
+        expect(RIGHT_PAREN, "')'");
+        tree[handler].child[0] = parameter;
+        return handler;
+    }
+
+    // Members are declarations, methods and constructors. Variables declared
+    // along with the type, "struct S {...} s;", are not kept.
+    uint32_t parseStruct() {
+        uint32_t node = tree.add(SYNTAX_STRUCT, advance().line);
+        uint32_t name = check(IDENTIFIER) ? symbolOf(advance()) : NO_SYMBOL;
+        tree[node].name = name;
+        if (match(LEFT_BRACE)) {
+            uint32_t members = parseList([&] {
+                uint32_t constructor = parseConstructorHead(name);
+                if (constructor != NONE) return parseFunctionRest(constructor);
+                return startsFunction() ? parseFunction() : parseStatement();
+            });
+            tree[node].child[0] = members;
+            expect(RIGHT_BRACE, "'}'");
+        }
+        return endStruct(node);
+    }
+
+    // The struct's name and a '(': a constructor, whose node is returned
+    // with the name consumed. NONE, consuming nothing, for anything else.
+    uint32_t parseConstructorHead(uint32_t name) {
+        if (!check(IDENTIFIER) || !check(LEFT_PAREN, 1) || symbolOf(peek()) != name) return NONE;
+        uint32_t constructor = tree.add(SYNTAX_FUNCTION, advance().line);
+        tree[constructor].op = IDENTIFIER;
+        tree[constructor].name = name;
+        return constructor;
+    }
+
+    uint32_t endStruct(uint32_t node) {
+        while (!check(SEMICOLON) && !check(RIGHT_BRACE) && !check(END_OF_FILE)) advance();
+        return endStatement(node);
+    }
+
+    // A type keyword, or a name followed by a name or a type keyword:
+    // "MyStruct obj", "const int".
+    bool startsDeclaration() {
+        if (isType(peek().type)) return true;
+        return check(IDENTIFIER) && (check(IDENTIFIER, 1) || isType(peek(1).type));
+    }
+
+    uint32_t parseDeclaration() {
+        uint32_t node = tree.add(SYNTAX_DECLARATION, peek().line);
+        tree[node].op = IDENTIFIER;
+        // Type words up to the first declared name.
+        while (isType(peek().type) ||
+               (check(IDENTIFIER) && (check(IDENTIFIER, 1) || isType(peek(1).type) ||
+                                      ((check(MULTIPLY, 1) || check(REFERENCE, 1)) && check(IDENTIFIER, 2))))) {
+            Token word = advance();
+            if (isType(word.type)) {
+                tree[node].op = word.type;
+            } else if (tree[node].op == IDENTIFIER) {
+                tree[node].name = symbolOf(word);
+            }
+        }
+
+        uint32_t variables = NONE;
+        do {
+            while (match(MULTIPLY) || match(REFERENCE)) {}
+            if (!check(IDENTIFIER)) {
+                error(peek(), "expected a name before ", peek());
+                synchronize();
+                tree[node].child[0] = variables;
+                return node;
+            }
+            Token name = advance();
+            uint32_t variable = tree.add(SYNTAX_VARIABLE, name.line);
+            tree[variable].name = symbolOf(name);
+            if (match(ASSIGN)) {
+                uint32_t value = parseExpression();
+                tree[variable].child[0] = value;
+            } else if (check(LEFT_PAREN)) {
+                uint32_t arguments = parseArguments();
+                tree[variable].child[1] = arguments;
+            }
+            append(variables, variable);
+        } while (match(COMMA));
+        tree[node].child[0] = variables;
+        return endStatement(node);
+    }
+
+    uint32_t parseExpressionStatement() {
+        uint32_t node = tree.add(SYNTAX_EXPRESSION, peek().line);
+        uint32_t expression = parseExpression();
+        tree[node].child[0] = expression;
+        return endStatement(node);
+    }
+
+    uint32_t parseArguments() {
+        expect(LEFT_PAREN, "'('");
+        uint32_t first = NONE;
+        if (!check(RIGHT_PAREN)) {
+            do {
+                uint32_t argument = parseExpression();
+                append(first, argument);
+            } while (match(COMMA));
+        }
+        expect(RIGHT_PAREN, "')'");
+        return first;
+    }
+
+    static TacOp arithmeticOp(TokenType type) {
+        switch (type) {
+            case PLUS: return TAC_ADD;
+            case MINUS: return TAC_SUB;
+            case MULTIPLY: return TAC_MUL;
+            case DIVIDE: return TAC_DIV;
+            default: return TAC_MOD;
+        }
+    }
+
+    bool binaryOperator(BinaryOperator &result) {
+        switch (TokenType type = peek().type) {
+            case ASSIGN: result = {TAC_ASSIGN, 1, true}; return true;
+            case PLUS_ASSIGN: result = {TAC_ADD, 1, true}; return true;
+            case MINUS_ASSIGN: result = {TAC_SUB, 1, true}; return true;
+            case MULTIPLY_ASSIGN: result = {TAC_MUL, 1, true}; return true;
+            case DIVIDE_ASSIGN: result = {TAC_DIV, 1, true}; return true;
+            case MODULO_ASSIGN: result = {TAC_MOD, 1, true}; return true;
+            case OR: result = {TAC_OR, 2, false}; return true;
+            case AND: result = {TAC_AND, 3, false}; return true;
+            case EQUAL: result = {TAC_EQ, 4, false}; return true;
+            case NOT_EQUAL: result = {TAC_NE, 4, false}; return true;
+            case LESS_THAN: result = {TAC_LT, 5, false}; return true;
+            case GREATER_THAN: result = {TAC_GT, 5, false}; return true;
+            case LESS_EQUAL: result = {TAC_LE, 5, false}; return true;
+            case GREATER_EQUAL: result = {TAC_GE, 5, false}; return true;
+            case SHIFT_LEFT: result = {TAC_SHL, 6, false}; return true;
+            case SHIFT_RIGHT: result = {TAC_SHR, 6, false}; return true;
+            case PLUS:
+            case MINUS:
+            case MULTIPLY:
+            case DIVIDE:
+            case MODULO:
+                result = {arithmeticOp(type), type == PLUS || type == MINUS ? 7 : 8, false};
+                return true;
+            default: return false;
+        }
+    }
+
+    // Precedence climbing: operators binding at least as tightly as
+    // `minPrecedence` are folded into the left operand, one loop iteration
+    // each. Assignments are right-associative.
+    uint32_t parseExpression(int minPrecedence = 1) {
+        if (mode == EXPLICIT_STACK) return parseExpressionWithFrames(minPrecedence);
+        uint32_t left = parseUnary();
+        BinaryOperator op;
+        while (binaryOperator(op) && op.precedence >= minPrecedence) {
+            Token token = advance();
+            uint32_t right = parseExpression(op.assignment ? op.precedence : op.precedence + 1);
+            uint32_t node = tree.add(op.assignment ? SYNTAX_ASSIGN : SYNTAX_BINARY, token.line);
+            tree[node].op = op.op;
+            if (op.assignment && !isAssignable(left)) error(token, "cannot assign to this expression");
+            set(node, left, right);
+            left = node;
+        }
+        return left;
+    }
+
+    bool isAssignable(uint32_t node) {
+        SyntaxKind kind = tree[node].kind;
+        return kind == SYNTAX_NAME || kind == SYNTAX_MEMBER || (kind == SYNTAX_UNARY && tree[node].op == TAC_DEREF);
+    }
+
+    uint32_t parseUnary() {
+        TokenType type = peek().type;
+        int line = peek().line;
+        TacOp op;
+        switch (type) {
+            case INCREMENT:
+            case DECREMENT: {  // ++x and --x are x += 1 and x -= 1
+                advance();
+                uint32_t operand = parseUnary();
+                uint32_t one = tree.add(SYNTAX_INTEGER, line);
+                tree[one].integer = 1;
+                uint32_t node = tree.add(SYNTAX_ASSIGN, line);
+                tree[node].op = type == INCREMENT ? TAC_ADD : TAC_SUB;
+                set(node, operand, one);
+                return node;
+            }
+            case PLUS:
+                advance();
+                return parseUnary();
+            case MINUS: op = TAC_NEG; break;
+            case LOGICAL_NOT: op = TAC_NOT; break;
+            case REFERENCE: op = TAC_ADDRESS; break;
+            case MULTIPLY: op = TAC_DEREF; break;
+            default: return parsePostfix();
+        }
+        advance();
+        uint32_t operand = parseUnary();
+        uint32_t node = tree.add(SYNTAX_UNARY, line);
+        tree[node].op = op;
+        set(node, operand);
+        return node;
+    }
+
+    uint32_t parsePostfix() {
+        uint32_t node = parsePrimary();
+        while (true) {
+            int line = peek().line;
+            if (check(LEFT_PAREN)) {
+                uint32_t arguments = parseArguments();
+                uint32_t call = tree.add(SYNTAX_CALL, line);
+                set(call, node, arguments);
+                node = call;
+            } else if (check(DOT) || check(MEMBER_ACCESS)) {
+                bool arrow = advance().type == MEMBER_ACCESS;
+                if (!check(IDENTIFIER)) {
+                    error(peek(), "expected a member name before ", peek());
+                    return node;
+                }
+                uint32_t member = symbolOf(advance());
+                uint32_t access = tree.add(SYNTAX_MEMBER, line);
+                tree[access].name = member;
+                tree[access].flags = arrow ? SyntaxNode::ARROW : 0;
+                set(access, node);
+                node = access;
+            } else if (check(INCREMENT) || check(DECREMENT)) {
+                TacOp op = advance().type == INCREMENT ? TAC_ADD : TAC_SUB;
+                uint32_t postfix = tree.add(SYNTAX_POSTFIX, line);
+                tree[postfix].op = op;
+                set(postfix, node);
+                node = postfix;
+            } else {
+                return node;
+            }
+        }
+    }
+
+    uint32_t parsePrimary() {
+        Token token = peek();
+        uint32_t node;
+        switch (token.type) {
+            case IDENTIFIER:
+                advance();
+                node = tree.add(SYNTAX_NAME, token.line);
+                tree[node].name = symbolOf(token);
+                return node;
+            case INTEGER_LITERAL:
+            case CHAR_LITERAL:
+                advance();
+                node = tree.add(SYNTAX_INTEGER, token.line);
+                tree[node].integer = token.number.integer;
+                return node;
+            case FLOAT_LITERAL:
+                advance();
+                node = tree.add(SYNTAX_REAL, token.line);
+                tree[node].real = token.number.real;
+                if (token.value.back() == 'f' || token.value.back() == 'F') tree[node].flags = SyntaxNode::SINGLE_PRECISION;
+                return node;
+            case STRING_LITERAL:
+                advance();
+                node = tree.add(SYNTAX_STRING, token.line);
+                tree[node].name = intern(token.value);
+                return node;
+            case LEFT_PAREN:
+                advance();
+                node = parseExpression();
+                expect(RIGHT_PAREN, "')'");
+                return node;
+            default:
+                error(token, "expected an expression before ", token);
+                // Punctuation that ends a statement, or opens a block, is left
+                // for it to recover at.
+                if (token.type != SEMICOLON && token.type != COMMA && token.type != RIGHT_PAREN &&
+                    token.type != LEFT_BRACE && token.type != RIGHT_BRACE && token.type != END_OF_FILE) {
+                    advance();
+                }
+                return tree.add(SYNTAX_ERROR, token.line);
+        }
+    }
+
+    // EXPLICIT_STACK mode. The rules above that nest are re-expressed as
+    // state machines: an open construct is a frame on a heap vector, the
+    // loop either starts a rule (pushing frames) or hands a finished node
+    // to the frame on top, and the rules that do not nest are shared with
+    // the recursive mode. Tokens are consumed and errors reported in the
+    // same order, so the tree and the error list are the same.
+
+    enum StatementState : uint8_t {
+        LIST_PROGRAM,  // Items of a list: a is the first, b the last; for the
+                       // program, c is the line of a statement being skipped
+        LIST_BLOCK,
+        LIST_MEMBERS,
+        IF_THEN,       // The then branch of node
+        BODY,          // The statement or block in child[a] of node
+        TRY_BODY,      // The body of a try; b: its handlers so far
+        CATCH_BODY     // The body of handler c of the try node
+    };
+
+    struct StatementFrame {
+        StatementState state;
+        uint32_t node;
+        uint32_t a, b, c;
+        size_t before;  // `consumed` when the list's current item started
+    };
+
+    enum ExpressionState : uint8_t {
+        OPERATORS,    // Folds binary operators of at least `precedence` into left
+        PREFIX,       // -x, !x, &x or *x: op
+        STEP,         // ++x or --x: op is TAC_ADD or TAC_SUB
+        PARENTHESIS,  // ( expression )
+        ARGUMENTS     // Of a call to left; right: the arguments so far
+    };
+
+    struct ExpressionFrame {
+        ExpressionState state;
+        TacOp op;
+        bool pending;     // OPERATORS: op waits for its right operand
+        bool assignment;  // Of the pending operator
+        int precedence;
+        int line, column;  // Of the pending operator, or of the prefix or call
+        uint32_t left, right;
+    };
+
+    vector<StatementFrame> statementFrames;
+    vector<ExpressionFrame> expressionFrames;
+
+    // parseItems, with parseStatement, parseBlock, parseFunctionRest,
+    // parseTry and parseStruct folded into one loop over statementFrames.
+    uint32_t parseItemsWithFrames() {
+        enum Step { NEXT_ITEM, STATEMENT, BLOCK, FUNCTION_REST, FINISHED };
+        Step step = NEXT_ITEM;
+        uint32_t value = NONE;  // The finished node, or the function for FUNCTION_REST
+        statementFrames.push_back({LIST_PROGRAM, NONE, NONE, NONE, NONE, 0});
+        for (;;) {
+            switch (step) {
+                case NEXT_ITEM: {  // parseList's loop, for the list on top
+                    StatementFrame &list = statementFrames.back();
+                    if (check(RIGHT_BRACE) || check(END_OF_FILE)) {
+                        if (list.state == LIST_PROGRAM) {
+                            if (check(END_OF_FILE)) {
+                                uint32_t items = list.a;
+                                statementFrames.pop_back();
+                                return items;
+                            }
+                            recovering = false;  // A '}' with no block open
+                            error(peek(), "unexpected ", peek());
+                            advance();
+                            continue;
+                        }
+                        uint32_t node = list.node, first = list.a;
+                        bool members = list.state == LIST_MEMBERS;
+                        statementFrames.pop_back();
+                        tree[node].child[0] = first;
+                        expect(RIGHT_BRACE, "'}'");
+                        value = members ? endStruct(node) : node;
+                        step = FINISHED;
+                        continue;
+                    }
+                    recovering = false;
+                    list.before = consumed;
+                    if (list.state == LIST_MEMBERS) {
+                        value = parseConstructorHead(tree[list.node].name);
+                        if (value != NONE) {
+                            step = FUNCTION_REST;
+                            continue;
+                        }
+                    }
+                    if (list.state != LIST_BLOCK && startsFunction()) {
+                        value = parseFunctionHead();
+                        step = FUNCTION_REST;
+                        continue;
+                    }
+                    if (list.state == LIST_PROGRAM && !startsGlobal()) {
+                        list.c = peek().line;
+                        error(peek(), "expected a declaration before ", peek());
+                    }
+                    step = STATEMENT;
+                    continue;
+                }
+                case STATEMENT:  // parseStatement
+                    switch (peek().type) {
+                        case LEFT_BRACE: step = BLOCK; continue;
+                        case IF: statementFrames.push_back({IF_THEN, parseIfHead(), 0, 0, 0, 0}); continue;
+                        case WHILE:
+                        case SWITCH: statementFrames.push_back({BODY, parseLoopHead(), 1, 0, 0, 0}); continue;
+                        case FOR: statementFrames.push_back({BODY, parseForHead(), 2, 0, 0, 0}); continue;
+                        case TRY:
+                            statementFrames.push_back({TRY_BODY, tree.add(SYNTAX_TRY, advance().line), 0, NONE, 0, 0});
+                            step = BLOCK;
+                            continue;
+                        case STRUCT: {
+                            uint32_t node = tree.add(SYNTAX_STRUCT, advance().line);
+                            tree[node].name = check(IDENTIFIER) ? symbolOf(advance()) : NO_SYMBOL;
+                            if (match(LEFT_BRACE)) {
+                                statementFrames.push_back({LIST_MEMBERS, node, NONE, NONE, 0, 0});
+                                step = NEXT_ITEM;
+                            } else {
+                                value = endStruct(node);
+                                step = FINISHED;
+                            }
+                            continue;
+                        }
+                        default:
+                            value = parseSimpleStatement();
+                            step = FINISHED;
+                            continue;
+                    }
+                case BLOCK: {  // parseBlock
+                    uint32_t block = tree.add(SYNTAX_BLOCK, peek().line);
+                    if (expect(LEFT_BRACE, "'{'")) {
+                        statementFrames.push_back({LIST_BLOCK, block, NONE, NONE, 0, 0});
+                        step = NEXT_ITEM;
+                    } else {
+                        value = block;
+                        step = FINISHED;
+                    }
+                    continue;
+                }
+                case FUNCTION_REST:
+                    if (parseSignature(value)) {
+                        statementFrames.push_back({BODY, value, 1, 0, 0, 0});
+                        step = BLOCK;
+                    } else {
+                        step = FINISHED;
+                    }
+                    continue;
+                case FINISHED:
+                    break;
+            }
+
+            // `value` is finished: it goes to the frame on top.
+            StatementFrame &frame = statementFrames.back();
+            switch (frame.state) {
+                case LIST_PROGRAM:
+                case LIST_BLOCK:
+                case LIST_MEMBERS:
+                    if (frame.state == LIST_PROGRAM && frame.c != NONE) {
+                        value = tree.add(SYNTAX_ERROR, frame.c);
+                        frame.c = NONE;
+                    }
+                    if (value != NONE) {
+                        if (frame.a == NONE) {
+                            frame.a = value;
+                        } else {
+                            tree[frame.b].next = value;
+                        }
+                        frame.b = value;
+                    }
+                    if (consumed == frame.before) advance();  // A token nothing can start with
+                    step = NEXT_ITEM;
+                    continue;
+                case IF_THEN:
+                    tree[frame.node].child[1] = value;
+                    if (match(ELSE)) {
+                        frame.state = BODY;
+                        frame.a = 2;
+                        step = STATEMENT;
+                        continue;
+                    }
+                    value = frame.node;
+                    statementFrames.pop_back();
+                    continue;
+                case BODY:
+                    tree[frame.node].child[frame.a] = value;
+                    value = frame.node;
+                    statementFrames.pop_back();
+                    continue;
+                case TRY_BODY:
+                    tree[frame.node].child[0] = value;
+                    break;
+                case CATCH_BODY:
+                    tree[frame.c].child[1] = value;
+                    append(frame.b, frame.c);
+                    break;
+            }
+            if (check(CATCH)) {
+                uint32_t handler = parseCatchHead();
+                StatementFrame &current = statementFrames.back();
+                current.state = CATCH_BODY;
+                current.c = handler;
+                step = BLOCK;
+                continue;
+            }
+            tree[frame.node].child[1] = frame.b;
+            value = frame.node;
+            statementFrames.pop_back();
+        }
+    }
+
+    // parseExpression, with parseUnary, parsePostfix, parsePrimary's
+    // parentheses and parseArguments folded into one loop over
+    // expressionFrames.
+    uint32_t parseExpressionWithFrames(int minPrecedence) {
+        enum Step { OPERAND, POSTFIX, FINISHED };
+        Step step = OPERAND;
+        uint32_t value = NONE;
+        size_t base = expressionFrames.size();
+        expressionFrames.push_back(operatorsFrame(minPrecedence));
+        for (;;) {
+            if (step == OPERAND) {  // parseUnary, down to a primary
+                TokenType type = peek().type;
+                int line = peek().line, column = peek().column;
+                if (type == INCREMENT || type == DECREMENT) {
+                    advance();
+                    expressionFrames.push_back(prefixFrame(STEP, type == INCREMENT ? TAC_ADD : TAC_SUB, line, column));
+                } else if (type == PLUS) {
+                    advance();
+                } else if (type == MINUS || type == LOGICAL_NOT || type == REFERENCE || type == MULTIPLY) {
+                    advance();
+                    TacOp op = type == MINUS ? TAC_NEG : type == LOGICAL_NOT ? TAC_NOT : type == REFERENCE ? TAC_ADDRESS : TAC_DEREF;
+                    expressionFrames.push_back(prefixFrame(PREFIX, op, line, column));
+                } else if (type == LEFT_PAREN) {
+                    advance();
+                    expressionFrames.push_back(prefixFrame(PARENTHESIS, TAC_ASSIGN, line, column));
+                    expressionFrames.push_back(operatorsFrame(1));
+                } else {
+                    value = parsePrimary();
+                    step = POSTFIX;
+                }
+                continue;
+            }
+            if (step == POSTFIX) {  // parsePostfix's loop
+                int line = peek().line, column = peek().column;
+                if (check(LEFT_PAREN)) {
+                    expect(LEFT_PAREN, "'('");
+                    if (!check(RIGHT_PAREN)) {
+                        ExpressionFrame call = prefixFrame(ARGUMENTS, TAC_CALL, line, column);
+                        call.left = value;
+                        expressionFrames.push_back(call);
+                        expressionFrames.push_back(operatorsFrame(1));
+                        step = OPERAND;
+                        continue;
+                    }
+                    expect(RIGHT_PAREN, "')'");
+                    uint32_t call = tree.add(SYNTAX_CALL, line);
+                    set(call, value);
+                    value = call;
+                } else if (check(DOT) || check(MEMBER_ACCESS)) {
+                    bool arrow = advance().type == MEMBER_ACCESS;
+                    if (!check(IDENTIFIER)) {
+                        error(peek(), "expected a member name before ", peek());
+                        step = FINISHED;
+                        continue;
+                    }
+                    uint32_t member = symbolOf(advance());
+                    uint32_t access = tree.add(SYNTAX_MEMBER, line);
+                    tree[access].name = member;
+                    tree[access].flags = arrow ? SyntaxNode::ARROW : 0;
+                    set(access, value);
+                    value = access;
+                } else if (check(INCREMENT) || check(DECREMENT)) {
+                    TacOp op = advance().type == INCREMENT ? TAC_ADD : TAC_SUB;
+                    uint32_t postfix = tree.add(SYNTAX_POSTFIX, line);
+                    tree[postfix].op = op;
+                    set(postfix, value);
+                    value = postfix;
+                } else {
+                    step = FINISHED;
+                }
+                continue;
+            }
+
+            // `value` is a finished operand or expression: it goes to the
+            // frame on top.
+            ExpressionFrame &frame = expressionFrames.back();
+            switch (frame.state) {
+                case PREFIX:
+                case STEP: {
+                    uint32_t node;
+                    if (frame.state == PREFIX) {
+                        node = tree.add(SYNTAX_UNARY, frame.line);
+                        set(node, value);
+                    } else {
+                        uint32_t one = tree.add(SYNTAX_INTEGER, frame.line);
+                        tree[one].integer = 1;
+                        node = tree.add(SYNTAX_ASSIGN, frame.line);
+                        set(node, value, one);
+                    }
+                    tree[node].op = frame.op;
+                    value = node;
+                    expressionFrames.pop_back();
+                    continue;
+                }
+                case PARENTHESIS:
+                    expressionFrames.pop_back();
+                    expect(RIGHT_PAREN, "')'");
+                    step = POSTFIX;
+                    continue;
+                case ARGUMENTS: {
+                    append(frame.right, value);
+                    if (match(COMMA)) {
+                        expressionFrames.push_back(operatorsFrame(1));
+                        step = OPERAND;
+                        continue;
+                    }
+                    ExpressionFrame call = frame;
+                    expressionFrames.pop_back();
+                    expect(RIGHT_PAREN, "')'");
+                    value = tree.add(SYNTAX_CALL, call.line);
+                    set(value, call.left, call.right);
+                    step = POSTFIX;
+                    continue;
+                }
+                case OPERATORS:
+                    break;
+            }
+            if (frame.pending) {
+                uint32_t node = tree.add(frame.assignment ? SYNTAX_ASSIGN : SYNTAX_BINARY, frame.line);
+                tree[node].op = frame.op;
+                if (frame.assignment && !isAssignable(frame.left)) {
+                    error(frame.line, frame.column, "cannot assign to this expression");
+                }
+                set(node, frame.left, value);
+                frame.left = node;
+                frame.pending = false;
+            } else {
+                frame.left = value;
+            }
+            BinaryOperator op;
+            if (binaryOperator(op) && op.precedence >= frame.precedence) {
+                Token token = advance();
+                frame.pending = true;
+                frame.op = op.op;
+                frame.assignment = op.assignment;
+                frame.line = token.line;
+                frame.column = token.column;
+                expressionFrames.push_back(operatorsFrame(op.assignment ? op.precedence : op.precedence + 1));
+                step = OPERAND;
+                continue;
+            }
+            value = frame.left;
+            expressionFrames.pop_back();
+            if (expressionFrames.size() == base) return value;
+        }
+    }
+
+    static ExpressionFrame operatorsFrame(int precedence) {
+        return {OPERATORS, TAC_ASSIGN, false, false, precedence, 0, 0, NONE, NONE};
+    }
+
+    static ExpressionFrame prefixFrame(ExpressionState state, TacOp op, int line, int column) {
+        return {state, op, false, false, 0, line, column, NONE, NONE};
+    }
+};
+
+// Parses a lexed token vector on several threads. A pre-scan matches braces
+// to find where each top-level function definition starts and ends; the
+// vector is cut into batches only there, and every batch is parsed by its
+// own Parser into its own arena as if it were a whole program. The batches'
+// items are then copied, in order, into one tree in the caller's arena.
+//
+// The pre-scan only matches brackets, so in a program with syntax errors it
+// can cut in the wrong place. A wrong cut leaves a batch that does not parse
+// cleanly, so if any batch reports a syntax error the whole vector is parsed
+// again on one thread, which also reports the errors exactly as Parser does.
+// When every batch is clean, the tree is the one Parser builds from the
+// whole vector.
+//
+// Splitting costs a serial pre-scan, a Parser per batch and the merge, so no
+// batch is shorter than minBatchTokens, a million tokens by default: smaller
+// inputs are parsed on one thread.
+class ParallelParser {
+public:
+    ParallelParser(const vector<Token> &tokens, Interner &interner, Arena *arena, ParseMode mode, size_t threads,
+                   size_t minBatchTokens = 1 << 20)
+        : tokens(tokens), interner(interner), arena(arena), mode(mode), threads(max<size_t>(threads, 1)),
+          minBatchTokens(max<size_t>(minBatchTokens, 1)) {}
+
+    // Parses the whole vector, which ends with END_OF_FILE. Call once.
+    SyntaxTree parse() {
+        if (threads > 1) split();
+        if (batches.size() > 1) {
+            ThreadPool pool(min(threads, batches.size()));
+            if (parseBatches(pool)) return merge(pool);
+        }
+        batches.clear();
+        TokenRange range(tokens, 0, tokens.size() - 1);
+        TokenStream<TokenRange> stream(range);
+        Parser<TokenStream<TokenRange>> parser(stream, interner, arena, mode);
+        SyntaxTree tree = parser.parse();
+        errorList = parser.errors();
+        return tree;
+    }
+
+    const vector<SyntaxError> &errors() const {
+        return errorList;
+    }
+
+    // Batches parse() split the vector into; 0 if it parsed on one thread.
+    size_t batchCount() const {
+        return batches.size();
+    }
+
+private:
+    // Tokens [begin, end) of the vector, then END_OF_FILE for good. The end
+    // token sits where token `end` does, so errors at the end of a batch are
+    // reported where they would be with the whole vector.
+    class TokenRange {
+    private:
+        const Token *next, *last;
+        Token endToken;
+
+    public:
+        TokenRange(const vector<Token> &tokens, size_t begin, size_t end)
+            : next(tokens.data() + begin), last(tokens.data() + end), endToken(tokens.back()) {
+            endToken.line = tokens[end].line;
+            endToken.column = tokens[end].column;
+            endToken.offset = tokens[end].offset;
+        }
+
+        Token nextToken() {
+            return next < last ? *next++ : endToken;
+        }
+    };
+
+    struct Batch {
+        size_t begin, end;
+        unique_ptr<Arena> arena = nullptr;  // Holds the batch's tree until it is merged
+        unique_ptr<SyntaxTree> tree = nullptr;
+        bool clean = false;
+    };
+
+    const vector<Token> &tokens;
+    Interner &interner;
+    Arena *arena;
+    ParseMode mode;
+    size_t threads;
+    size_t minBatchTokens;
+    vector<Batch> batches;
+    vector<SyntaxError> errorList;
+    mutex internerLock;
+
+    // A few batches per thread, so one long function doesn't hold up the
+    // rest, but none shorter than minBatchTokens.
+    void split() {
+        batches.clear();
+        size_t end = tokens.size() - 1;  // END_OF_FILE is not in any batch
+        size_t target = max(minBatchTokens, end / (threads * 4));
+        size_t begin = 0;
+        for (size_t cut : preScan()) {
+            if (cut - begin < target || end - cut < target) continue;
+            batches.push_back({begin, cut});
+            begin = cut;
+        }
+        if (!batches.empty()) batches.push_back({begin, end});
+    }
+
+    // Parses every batch; false if any of them has a syntax error.
+    bool parseBatches(ThreadPool &pool) {
+        pool.parallelFor(batches.size(), [&](size_t i) { parseBatch(batches[i]); });
+        for (const Batch &batch : batches) {
+            if (!batch.clean) return false;
+        }
+        return true;
+    }
+
+    void parseBatch(Batch &batch) {
+        batch.arena = make_unique<Arena>();
+        TokenRange range(tokens, batch.begin, batch.end);
+        TokenStream<TokenRange> stream(range);
+        Parser<TokenStream<TokenRange>> parser(stream, interner, batch.arena.get(), mode);
+        parser.shareInterner(internerLock);
+        batch.tree = make_unique<SyntaxTree>(parser.parse());
+        batch.clean = parser.errors().empty();
+    }
+
+    // Each batch's nodes are copied to their own range of the tree, all at
+    // once; then the batches' item lists are chained in order.
+    SyntaxTree merge(ThreadPool &pool) {
+        vector<uint32_t> at(batches.size()), first(batches.size());
+        size_t size = 1;
+        for (size_t i = 0; i < batches.size(); ++i) {
+            at[i] = (uint32_t)size;
+            size += batches[i].tree->size() - 1;
+        }
+        SyntaxTree tree(arena);
+        uint32_t program = tree.add(SYNTAX_PROGRAM, tokens[0].line);
+        tree.resize(size);
+        pool.parallelFor(batches.size(), [&](size_t i) {
+            first[i] = tree.copyItems(*batches[i].tree, at[i]);
+            batches[i].tree.reset();
+            batches[i].arena.reset();
+        });
+
+        uint32_t last = SyntaxNode::NONE;
+        for (uint32_t item : first) {
+            if (item == SyntaxNode::NONE) continue;
+            if (last == SyntaxNode::NONE) {
+                tree[program].child[0] = item;
+            } else {
+                tree[last].next = item;
+            }
+            for (last = item; tree[last].next != SyntaxNode::NONE; last = tree[last].next) {}
+        }
+        tree.root = program;
+        return tree;
+    }
+
+    // Token indices where top-level function definitions start and end, in
+    // order. A definition is "type name (" as Parser::startsFunction sees
+    // it, at the start of an item outside any braces or parentheses, whose
+    // ')' is followed by a '{'. On the way, string literals are interned in
+    // stream order, so that the batches only look them up and ids come out
+    // as they would from one Parser.
+    vector<size_t> preScan() {
+        vector<size_t> boundaries;
+        size_t end = tokens.size() - 1;
+        int depth = 0;
+        bool itemStart = true;
+        size_t i = 0;
+        while (i < end) {
+            size_t functionEnd = depth == 0 && itemStart ? definitionEnd(i) : 0;
+            if (functionEnd) {
+                boundaries.push_back(i);
+                boundaries.push_back(functionEnd);
+                i = functionEnd;
+                continue;
+            }
+            TokenType type = tokens[i++].type;
+            if (type == STRING_LITERAL) interner.intern(tokens[i - 1].value);
+            if (type == LEFT_BRACE || type == LEFT_PAREN) {
+                depth++;
+            } else if ((type == RIGHT_BRACE || type == RIGHT_PAREN) && depth > 0) {
+                depth--;
+            }
+            itemStart = type == SEMICOLON || type == RIGHT_BRACE;
+        }
+        return boundaries;
+    }
+
+    // Index just past the body of the definition starting at token i, or 0
+    // if none does.
+    size_t definitionEnd(size_t i) {
+        TokenType type = tokens[i].type;
+        if (type != INT && type != FLOAT && type != DOUBLE && type != CHAR && type != STRING && type != VOID &&
+            type != IDENTIFIER) {
+            return 0;
+        }
+        size_t k = tokens[i + 1].type == MULTIPLY || tokens[i + 1].type == REFERENCE ? i + 2 : i + 1;
+        if (tokens[k].type != IDENTIFIER || tokens[k + 1].type != LEFT_PAREN) return 0;
+        size_t j = matching(k + 1, LEFT_PAREN, RIGHT_PAREN);
+        if (!j || tokens[j].type != LEFT_BRACE) return 0;
+        return matching(j, LEFT_BRACE, RIGHT_BRACE);
+    }
+
+    // Index just past the `close` matching the `open` at token i, or 0 if
+    // the input ends first. Parentheses stop at any brace or ';'.
+    size_t matching(size_t i, TokenType open, TokenType close) {
+        size_t end = tokens.size() - 1;
+        int depth = 0;
+        while (i < end) {
+            TokenType type = tokens[i++].type;
+            if (type == STRING_LITERAL) interner.intern(tokens[i - 1].value);
+            if (type == open) {
+                depth++;
+            } else if (type == close) {
+                if (--depth == 0) return i;
+            } else if (open == LEFT_PAREN && (type == LEFT_BRACE || type == RIGHT_BRACE || type == SEMICOLON)) {
+                return 0;
+            }
+        }
+        return 0;
+    }
+};
+
+// Lowers a SyntaxTree to three-address code by syntax-directed translation:
+// one rule per node kind, which emits its children's code and combines
+// their results. Expressions are given the variable their value is for, so
+// "x = a + b" is one instruction rather than a temporary and a copy, and
+// integer constants are folded on the way. Conditions become jumps, so &&
+// and || short-circuit. Code outside any function (global initializers)
+// runs at the start of main, which is made up if the program has none.
+// Like Parser, it lowers by recursion by default and with heap frames in
+// EXPLICIT_STACK mode, for trees nested deeper than the native stack allows.
+class IntermediateCodeGenerator {
+public:
+    struct ThreeAddressCode {
+        TacOp op;
+        Operand arg1;
+        Operand arg2;
+        Operand result;
+
+        // One instruction in the forms listed at TacOp.
+        template <typename Out>
+        void format(Out &out, const Interner &interner) const {
+            switch (op) {
+                case TAC_LABEL:
+                    result.format(out, interner);
+                    out << ':';
+                    return;
+                case TAC_GOTO:
+                case TAC_FUNCTION:
+                case TAC_END:
+                    out << tacOpSymbol(op) << ' ';
+                    result.format(out, interner);
+                    return;
+                case TAC_IF:
+                case TAC_IF_FALSE:
+                    out << tacOpSymbol(op) << ' ';
+                    arg1.format(out, interner);
+                    out << " goto ";
+                    result.format(out, interner);
+                    return;
+                case TAC_PARAM:
+                case TAC_RETURN:
+                    out << tacOpSymbol(op);
+                    if (!arg1.empty()) {
+                        out << ' ';
+                        arg1.format(out, interner);
+                    }
+                    return;
+                case TAC_STORE:
+                    out << '*';
+                    result.format(out, interner);
+                    out << " = ";
+                    arg1.format(out, interner);
+                    return;
+                case TAC_CALL:
+                    if (!result.empty()) {
+                        result.format(out, interner);
+                        out << " = ";
+                    }
+                    out << "call ";
+                    arg1.format(out, interner);
+                    out << ", ";
+                    arg2.format(out, interner);
+                    return;
+                default:
+                    break;
+            }
+            result.format(out, interner);
+            out << " = ";
+            if (op >= TAC_NEG) out << tacOpSymbol(op);
+            arg1.format(out, interner);
+            if (!arg2.empty()) {
+                out << " " << tacOpSymbol(op) << " ";
+                arg2.format(out, interner);
+            }
+        }
+
+        string toString(const Interner &interner) const {
+            ostringstream out;
+            format(out, interner);
+            return out.str();
+        }
+    };
+
+    using Code = ArenaVector<ThreeAddressCode>;
+
+    // Generated code is allocated from `arena` when one is given. `mode` is
+    // used for lowering, and for parsing when generate() is given tokens.
+    explicit IntermediateCodeGenerator(Interner &interner, Arena *arena = nullptr, ParseMode mode = RECURSIVE_DESCENT)
+        : interner(interner), arena(arena), mode(mode), breakLabels(arena), continueLabels(arena), switchCases(arena),
+          switchStarts(arena), handlers(arena), arguments(arena), lowerFrames(arena), caseSearch(arena) {}
+
+    // The tree must be free of syntax errors (see Parser::errors).
+    Code generate(const SyntaxTree &syntaxTree) {
+        Code intermediateCode(arena);
+        tree = &syntaxTree;
+        code = &intermediateCode;
+        temps = labels = 0;
+        if (syntaxTree.root != SyntaxNode::NONE) lowerProgram(syntaxTree[syntaxTree.root]);
+        tree = nullptr;
+        code = nullptr;
+        return intermediateCode;
+    }
+
+    // Parses tokens up to END_OF_FILE and lowers the tree. After a syntax
+    // error there is no code: use Parser directly to report the errors.
+    template <typename Source, size_t N>
+    Code generate(TokenStream<Source, N> &tokens) {
+        Parser<TokenStream<Source, N>> parser(tokens, interner, arena, mode);
+        SyntaxTree syntaxTree = parser.parse();
+        if (!parser.errors().empty()) return Code(arena);
+        return generate(syntaxTree);
+    }
+
+    Code generate(const TokenBuffer &tokens) {
+        TokenBuffer::Reader reader(tokens);
+        TokenStream<TokenBuffer::Reader> stream(reader);
+        return generate(stream);
+    }
+
+private:
+    static constexpr uint32_t NONE = SyntaxNode::NONE;
+
+    // Where a throw inside a try block goes: the first handler, with the
+    // thrown value in its parameter.
+    struct Handler {
+        Operand label;
+        Operand parameter;
+    };
+
+    Interner &interner;
+    Arena *arena;
+    ParseMode mode;
+    const SyntaxTree *tree = nullptr;
+    Code *code = nullptr;
+    uint32_t temps = 0, labels = 0;
+    // Scratch stacks, on the arena with the code and kept across generate()
+    // calls, so lowering allocates nothing per statement.
+    ArenaVector<Operand> breakLabels, continueLabels;
+    ArenaVector<pair<uint32_t, Operand>> switchCases;  // Case node and its label, for all open switches
+    ArenaVector<size_t> switchStarts;                  // Where each open switch's cases begin
+    ArenaVector<Handler> handlers;
+    ArenaVector<Operand> arguments;  // Of the calls being lowered
+    string memberName;
+
+    const SyntaxNode &node(uint32_t i) const {
+        return (*tree)[i];
+    }
+
+    Operand newTemp() {
+        return {OPERAND_TEMP, temps++};
+    }
+
+    Operand newLabel() {
+        return {OPERAND_LABEL, labels++};
+    }
+
+    void emit(TacOp op, Operand arg1, Operand arg2, Operand result) {
+        code->push_back({op, arg1, arg2, result});
+    }
+
+    void emitLabel(Operand label) {
+        emit(TAC_LABEL, NO_OPERAND, NO_OPERAND, label);
+    }
+
+    void emitGoto(Operand label) {
+        emit(TAC_GOTO, NO_OPERAND, NO_OPERAND, label);
+    }
+
+    void lowerProgram(const SyntaxNode &program) {
+        uint32_t mainName = interner.intern("main");
+        bool hasMain = false;
+        ArenaVector<uint32_t> globals(arena);
+        for (uint32_t item = program.child[0]; item != NONE; item = node(item).next) {
+            if (node(item).kind != SYNTAX_FUNCTION) {
+                globals.push_back(item);
+            } else if (node(item).name == mainName && node(item).child[1] != NONE) {
+                hasMain = true;
+            }
+        }
+        if (!hasMain && !globals.empty()) {
+            Operand entry = {OPERAND_NAME, mainName};
+            size_t start = code->size();
+            emit(TAC_FUNCTION, NO_OPERAND, NO_OPERAND, entry);
+            for (uint32_t global : globals) lowerItem(global);
+            if (code->size() == start + 1) {
+                code->pop_back();
+            } else {
+                emit(TAC_END, NO_OPERAND, NO_OPERAND, entry);
+            }
+        }
+        for (uint32_t item = program.child[0]; item != NONE; item = node(item).next) {
+            const SyntaxNode &function = node(item);
+            if (function.kind != SYNTAX_FUNCTION || function.child[1] == NONE) continue;
+            Operand name = {OPERAND_NAME, function.name};
+            emit(TAC_FUNCTION, NO_OPERAND, NO_OPERAND, name);
+            if (function.name == mainName) {
+                for (uint32_t global : globals) lowerItem(global);
+            }
+            lowerItem(function.child[1]);
+            emit(TAC_END, NO_OPERAND, NO_OPERAND, name);
+        }
+    }
+
+    // A global declaration or a function body, in the generator's mode.
+    void lowerItem(uint32_t i) {
+        if (mode == EXPLICIT_STACK) {
+            lowerWithFrames(i);
+        } else {
+            lowerStatement(i);
+        }
+    }
+
+    void lowerStatement(uint32_t i) {
+        const SyntaxNode &statement = node(i);
+        switch (statement.kind) {
+            case SYNTAX_BLOCK:
+                for (uint32_t s = statement.child[0]; s != NONE; s = node(s).next) lowerStatement(s);
+                break;
+            case SYNTAX_DECLARATION:
+                for (uint32_t v = statement.child[0]; v != NONE; v = node(v).next) lowerVariable(statement, node(v));
+                break;
+            case SYNTAX_EXPRESSION: lowerEffect(statement.child[0]); break;
+            case SYNTAX_IF: {
+                Operand otherwise = newLabel();
+                branch(statement.child[0], otherwise, false);
+                lowerStatement(statement.child[1]);
+                if (statement.child[2] == NONE) {
+                    emitLabel(otherwise);
+                    break;
+                }
+                Operand end = newLabel();
+                emitGoto(end);
+                emitLabel(otherwise);
+                lowerStatement(statement.child[2]);
+                emitLabel(end);
+                break;
+            }
+            case SYNTAX_WHILE: {
+                Operand top = newLabel(), end = newLabel();
+                emitLabel(top);
+                branch(statement.child[0], end, false);
+                lowerLoopBody(statement.child[1], end, top);
+                emitGoto(top);
+                emitLabel(end);
+                break;
+            }
+            case SYNTAX_FOR: {
+                if (statement.child[0] != NONE) lowerStatement(statement.child[0]);
+                Operand top = newLabel(), step = newLabel(), end = newLabel();
+                emitLabel(top);
+                if (statement.child[1] != NONE) branch(statement.child[1], end, false);
+                lowerLoopBody(statement.child[2], end, step);
+                emitLabel(step);
+                if (statement.extra != NONE) lowerEffect(statement.extra);
+                emitGoto(top);
+                emitLabel(end);
+                break;
+            }
+            case SYNTAX_SWITCH: lowerSwitch(statement); break;
+            case SYNTAX_CASE:
+            case SYNTAX_DEFAULT: lowerCaseLabel(i); break;
+            case SYNTAX_BREAK:
+                if (!breakLabels.empty()) emitGoto(breakLabels.back());
+                break;
+            case SYNTAX_CONTINUE:
+                if (!continueLabels.empty()) emitGoto(continueLabels.back());
+                break;
+            case SYNTAX_RETURN: {
+                Operand value = statement.child[0] == NONE ? NO_OPERAND : lowerExpression(statement.child[0], NO_OPERAND);
+                emit(TAC_RETURN, value, NO_OPERAND, NO_OPERAND);
+                break;
+            }
+            case SYNTAX_TRY: lowerTry(statement); break;
+            case SYNTAX_THROW:
+                if (handlers.empty()) {
+                    emitThrow(lowerExpression(statement.child[0], NO_OPERAND));
+                } else {
+                    Handler handler = handlers.back();
+                    if (handler.parameter.empty()) {
+                        lowerEffect(statement.child[0]);
+                    } else {
+                        lowerExpression(statement.child[0], handler.parameter);
+                    }
+                    emitGoto(handler.label);
+                }
+                break;
+            default:
+                break;  // Structs, functions in them, empty statements and errors have no code
+        }
+    }
 
-        auto it = typeNames.find(type);
-        string typeName = it != typeNames.end() ? it->second : "UNKNOWN";
-        return "Token{type: " + typeName + ", value: '" + value + "', line: " + to_string(line) + ", column: " + to_string(column) + "}";
+    void lowerLoopBody(uint32_t body, Operand breakLabel, Operand continueLabel) {
+        breakLabels.push_back(breakLabel);
+        continueLabels.push_back(continueLabel);
+        lowerStatement(body);
+        breakLabels.pop_back();
+        continueLabels.pop_back();
     }
-};
 
-// Symbol Table Class
-class SymbolTable {
-private:
-    struct Symbol {
-        string identifier;
-        string type;
-        string value;
-        string scope;
-        int line;
+    // "T x = v" assigns v; "T x(args)" calls T's constructor, or for a
+    // built-in T assigns the first argument.
+    void lowerVariable(const SyntaxNode &declaration, const SyntaxNode &variable) {
+        Operand name = {OPERAND_NAME, variable.name};
+        if (variable.child[0] != NONE) {
+            lowerExpression(variable.child[0], name);
+        } else if (variable.child[1] != NONE) {
+            if (declaration.op == IDENTIFIER) {
+                lowerCall({OPERAND_NAME, declaration.name}, variable.child[1], name);
+            } else {
+                lowerExpression(variable.child[1], name);
+            }
+        }
+    }
 
-        string toString() const {
-            return identifier + " | " + type + " | " + value + " | " + scope + " | " + to_string(line);
+    // Tests each case value in order, then jumps to default or out; the body
+    // follows with a label at each case.
+    void lowerSwitch(const SyntaxNode &statement) {
+        Operand value = lowerExpression(statement.child[0], NO_OPERAND);
+        size_t base = switchCases.size();
+        collectCases(statement.child[1]);
+        Operand end = newLabel(), fallback = end;
+        for (size_t c = base; c < switchCases.size(); ++c) {
+            pair<uint32_t, Operand> entry = switchCases[c];
+            const SyntaxNode &label = node(entry.first);
+            if (label.kind == SYNTAX_DEFAULT) {
+                fallback = entry.second;
+                continue;
+            }
+            testCase(value, lowerExpression(label.child[0], NO_OPERAND), entry.second);
         }
-    };
+        emitGoto(fallback);
+        switchStarts.push_back(base);
+        breakLabels.push_back(end);
+        lowerStatement(statement.child[1]);
+        breakLabels.pop_back();
+        switchStarts.pop_back();
+        switchCases.resize(base);
+        emitLabel(end);
+    }
 
-    vector<Symbol> symbols;
+    void testCase(Operand value, Operand test, Operand label) {
+        Operand folded;
+        if (fold(TAC_EQ, value, test, folded)) {
+            if (folded.integer) emitGoto(label);
+            return;
+        }
+        Operand equal = newTemp();
+        emit(TAC_EQ, value, test, equal);
+        emit(TAC_IF, equal, NO_OPERAND, label);
+    }
 
-public:
-    void addEntry(const string &identifier, const string &type, const string &value, const string &scope, int line) {
-        symbols.push_back({identifier, type, value, scope, line});
+    void lowerCaseLabel(uint32_t i) {
+        if (switchStarts.empty()) return;
+        for (size_t c = switchStarts.back(); c < switchCases.size(); ++c) {
+            if (switchCases[c].first == i) emitLabel(switchCases[c].second);
+        }
     }
 
-    void print() const {
-        cout << "\nSymbol Table:\n";
-        cout << setw(15) << "Identifier" << " | " 
-             << setw(10) << "Type" << " | " 
-             << setw(10) << "Scope" << " | " 
-             << setw(5) << "Line" << "\n";
-        cout << string(60, '-') << "\n";
-        for (const auto &symbol : symbols) {
-            cout << setw(15) << symbol.identifier << " | "
-                 << setw(10) << symbol.type << " | "
-                 << setw(10) << symbol.scope << " | "
-                 << setw(5) << symbol.line << "\n";
+    // Appends the case labels of a switch body to switchCases, in order, not
+    // looking into nested switches. The statements still to look at are kept
+    // on caseSearch rather than the native stack.
+    void collectCases(uint32_t first) {
+        caseSearch.push_back(first);
+        while (!caseSearch.empty()) {
+            uint32_t i = caseSearch.back();
+            caseSearch.pop_back();
+            if (i == NONE) continue;
+            const SyntaxNode &statement = node(i);
+            caseSearch.push_back(statement.next);
+            switch (statement.kind) {
+                case SYNTAX_CASE:
+                case SYNTAX_DEFAULT: switchCases.push_back({i, newLabel()}); break;
+                case SYNTAX_BLOCK:
+                case SYNTAX_IF:
+                case SYNTAX_WHILE:
+                case SYNTAX_FOR:
+                case SYNTAX_TRY:
+                case SYNTAX_CATCH:
+                    for (int c = 2; c >= 0; --c) caseSearch.push_back(statement.child[c]);
+                    break;
+                default: break;
+            }
         }
     }
-};
 
-// Lexer Class
-class Lexer {
-private:
-    string source;
-    size_t current;
-    int line, column;
-    vector<Token> tokens;
+    // A throw lexically inside the try block jumps to the first handler; the
+    // handler's type is not checked.
+    void lowerTry(const SyntaxNode &statement) {
+        Operand handlerLabel = newLabel(), end = newLabel();
+        pushHandler(statement, handlerLabel);
+        lowerStatement(statement.child[0]);
+        handlers.pop_back();
+        emitGoto(end);
+        emitLabel(handlerLabel);
+        if (statement.child[1] != NONE) lowerStatement(node(statement.child[1]).child[1]);
+        emitLabel(end);
+    }
 
-public:
-    SymbolTable symbolTable;
-    string currentScope = "global";
+    void pushHandler(const SyntaxNode &statement, Operand label) {
+        uint32_t handler = statement.child[1];
+        uint32_t parameter = handler == NONE ? NONE : node(handler).child[0];
+        handlers.push_back({label, parameter == NONE ? NO_OPERAND : Operand{OPERAND_NAME, node(parameter).name}});
+    }
 
-    Lexer(const string &src) : source(src), current(0), line(1), column(1) {}
+    // A throw outside any try: left to the runtime.
+    void emitThrow(Operand value) {
+        emit(TAC_PARAM, value, NO_OPERAND, NO_OPERAND);
+        emit(TAC_CALL, {OPERAND_NAME, interner.intern("throw")}, Operand::integerConstant(1), NO_OPERAND);
+    }
 
-    vector<Token> tokenize() {
-        tokens.clear();
-        while (!isAtEnd()) {
-            char c = advance();
+    // An expression evaluated for its effect: x++ does not keep the old
+    // value, and a call's result is not stored.
+    void lowerEffect(uint32_t i) {
+        const SyntaxNode &expression = node(i);
+        if (expression.kind == SYNTAX_POSTFIX) {
+            Operand variable = lowerExpression(expression.child[0], NO_OPERAND);
+            emit((TacOp)expression.op, variable, Operand::integerConstant(1), variable);
+        } else if (expression.kind == SYNTAX_CALL) {
+            lowerCall(lowerExpression(expression.child[0], NO_OPERAND), expression.child[1], NO_OPERAND);
+        } else {
+            lowerExpression(i, NO_OPERAND);
+        }
+    }
 
-            if (isspace(c)) {
-                if (c == '\n') {
-                    line++;
-                    column = 1;
+    // Returns the operand holding the expression's value. With a target the
+    // value ends up in the target; without one, names and constants are
+    // returned as they are and computed values get a new temporary.
+    Operand lowerExpression(uint32_t i, Operand target) {
+        const SyntaxNode &expression = node(i);
+        switch (expression.kind) {
+            case SYNTAX_MEMBER: return memberValue(expression, lowerExpression(expression.child[0], NO_OPERAND), target);
+            case SYNTAX_BINARY: {
+                if (expression.op == TAC_AND || expression.op == TAC_OR) {
+                    // 0 or 1, by way of the jumps.
+                    Operand result = newTemp(), done = newLabel();
+                    emit(TAC_ASSIGN, Operand::integerConstant(0), NO_OPERAND, result);
+                    branch(i, done, false);
+                    emit(TAC_ASSIGN, Operand::integerConstant(1), NO_OPERAND, result);
+                    emitLabel(done);
+                    return assignTo(result, target);
                 }
-                continue;
+                Operand left = lowerExpression(expression.child[0], NO_OPERAND);
+                Operand right = lowerExpression(expression.child[1], NO_OPERAND);
+                return binaryValue((TacOp)expression.op, left, right, target);
             }
-
-            switch (c) {
-                case '+': tokens.push_back(createToken(PLUS, "+")); break;
-                case '-': tokens.push_back(createToken(MINUS, "-")); break;
-                case '*': tokens.push_back(createToken(MULTIPLY, "*")); break;
-                case '/': tokens.push_back(createToken(DIVIDE, "/")); break;
-                case '%': tokens.push_back(createToken(MODULO, "%")); break;
-                case '=': tokens.push_back(match('=') ? createToken(EQUAL, "==") : createToken(ASSIGN, "=")); break;
-                case '<': tokens.push_back(match('=') ? createToken(LESS_EQUAL, "<=") : createToken(LESS_THAN, "<")); break;
-                case '>': tokens.push_back(match('=') ? createToken(GREATER_EQUAL, ">=") : createToken(GREATER_THAN, ">")); break;
-                case '!': tokens.push_back(match('=') ? createToken(NOT_EQUAL, "!=") : createToken(LOGICAL_NOT, "!")); break;
-                case '&': tokens.push_back(match('&') ? createToken(AND, "&&") : createToken(REFERENCE, "&")); break;
-                case '|': tokens.push_back(match('|') ? createToken(OR, "||") : createToken(UNKNOWN, "|")); break;
-                case '(': tokens.push_back(createToken(LEFT_PAREN, "(")); break;
-                case ')': tokens.push_back(createToken(RIGHT_PAREN, ")")); break;
-                case '{': tokens.push_back(createToken(LEFT_BRACE, "{")); break;
-                case '}': tokens.push_back(createToken(RIGHT_BRACE, "}")); break;
-                case ';': tokens.push_back(createToken(SEMICOLON, ";")); break;
-                case ',': tokens.push_back(createToken(COMMA, ",")); break;
-                case '"': tokens.push_back(tokenizeStringLiteral()); break;
-                // case '*': tokens.push_back(createToken(DEREFERENCE, "*")); break;
-                
-                // case '': 
-                //     if (match('>')) tokens.push_back(createToken(MEMBER_ACCESS, "->"));
-                //     break;
-                default:
-                    if (isdigit(c)) {
-                        tokens.push_back(tokenizeNumber(c));
-                    } else if (isalpha(c) || c == '_') {
-                        tokens.push_back(tokenizeIdentifierOrKeyword(c));
-                    } else {
-                        tokens.push_back(createToken(UNKNOWN, string(1, c)));
-                    }
+            case SYNTAX_UNARY:
+                return unaryValue((TacOp)expression.op, lowerExpression(expression.child[0], NO_OPERAND), target);
+            case SYNTAX_ASSIGN: return assignTo(lowerAssignment(expression), target);
+            case SYNTAX_POSTFIX:
+                return postfixValue((TacOp)expression.op, lowerExpression(expression.child[0], NO_OPERAND), target);
+            case SYNTAX_CALL: {
+                Operand callee = lowerExpression(expression.child[0], NO_OPERAND);
+                return lowerCall(callee, expression.child[1], target.empty() ? newTemp() : target);
             }
+            default: return assignTo(leafValue(expression), target);
         }
-
-        tokens.push_back({END_OF_FILE, "", line, column});
-        return tokens;
     }
 
-private:
-    bool isAtEnd() const {
-        return current >= source.length();
+    // Names and literals. There is no SYNTAX_ERROR here: a tree with errors
+    // is not lowered.
+    static Operand leafValue(const SyntaxNode &expression) {
+        switch (expression.kind) {
+            case SYNTAX_NAME: return {OPERAND_NAME, expression.name};
+            case SYNTAX_INTEGER: return Operand::integerConstant(expression.integer);
+            case SYNTAX_REAL:
+                return Operand::realConstant(expression.real, expression.flags & SyntaxNode::SINGLE_PRECISION);
+            default:
+                assert(expression.kind == SYNTAX_STRING);
+                return {OPERAND_STRING, expression.name};
+        }
     }
 
-    char advance() {
-        column++;
-        return source[current++];
+    Operand assignTo(Operand value, Operand target) {
+        if (target.empty() || value == target) return value;
+        emit(TAC_ASSIGN, value, NO_OPERAND, target);
+        return target;
     }
 
-    bool match(char expected) {
-        if (isAtEnd() || source[current] != expected) return false;
-        current++;
-        column++;
-        return true;
+    // "obj.value" is one name: operands have no structure.
+    Operand memberValue(const SyntaxNode &member, Operand object, Operand target) {
+        memberName.clear();
+        if (object.kind == OPERAND_NAME) {
+            memberName += interner.name(object.id);
+        } else {
+            memberName += object.toString(interner);
+        }
+        memberName += member.flags & SyntaxNode::ARROW ? "->" : ".";
+        memberName += interner.name(member.name);
+        return assignTo({OPERAND_NAME, interner.intern(memberName)}, target);
     }
 
-    Token createToken(TokenType type, const string &value = "") {
-        return {type, value, line, column};
+    Operand binaryValue(TacOp op, Operand left, Operand right, Operand target) {
+        Operand folded;
+        if (fold(op, left, right, folded)) return assignTo(folded, target);
+        Operand result = target.empty() ? newTemp() : target;
+        emit(op, left, right, result);
+        return result;
     }
 
-    Token tokenizeNumber(char first) {
-        string number(1, first);
-        while (!isAtEnd() && isdigit(source[current])) {
-            number += advance();
+    Operand unaryValue(TacOp op, Operand operand, Operand target) {
+        if (op == TAC_NOT && operand.kind == OPERAND_INTEGER) {
+            return assignTo(Operand::integerConstant(operand.integer == 0), target);
         }
+        Operand result = target.empty() ? newTemp() : target;
+        emit(op, operand, NO_OPERAND, result);
+        return result;
+    }
 
-        if (!isAtEnd() && source[current] == '.') {
-            number += advance();
-            while (!isAtEnd() && isdigit(source[current])) {
-                number += advance();
-            }
-            return {FLOAT_LITERAL, number, line, column};
+    // The old value is the result.
+    Operand postfixValue(TacOp op, Operand variable, Operand target) {
+        Operand old = target.empty() ? newTemp() : target;
+        emit(TAC_ASSIGN, variable, NO_OPERAND, old);
+        emit(op, variable, Operand::integerConstant(1), variable);
+        return old;
+    }
+
+    // x = v, x op= v and *p = v. Returns where the value now is.
+    Operand lowerAssignment(const SyntaxNode &assignment) {
+        TacOp op = (TacOp)assignment.op;
+        const SyntaxNode &target = node(assignment.child[0]);
+        if (target.kind == SYNTAX_UNARY && target.op == TAC_DEREF) {
+            Operand pointer = lowerExpression(target.child[0], NO_OPERAND);
+            return store(op, pointer, lowerExpression(assignment.child[1], NO_OPERAND));
         }
+        Operand variable = lowerExpression(assignment.child[0], NO_OPERAND);
+        if (op == TAC_ASSIGN) return lowerExpression(assignment.child[1], variable);
+        Operand value = lowerExpression(assignment.child[1], NO_OPERAND);
+        emit(op, variable, value, variable);
+        return variable;
+    }
 
-        return {INTEGER_LITERAL, number, line, column};
+    // *pointer = value, or *pointer op= value.
+    Operand store(TacOp op, Operand pointer, Operand value) {
+        if (op != TAC_ASSIGN) {
+            Operand old = newTemp(), updated = newTemp();
+            emit(TAC_DEREF, pointer, NO_OPERAND, old);
+            emit(op, old, value, updated);
+            value = updated;
+        }
+        emit(TAC_STORE, value, NO_OPERAND, pointer);
+        return value;
     }
 
-    Token tokenizeIdentifierOrKeyword(char first) {
-        string identifier(1, first);
-        while (!isAtEnd() && (isalnum(source[current]) || source[current] == '_')) {
-            identifier += advance();
+    // Arguments are evaluated left to right, then passed. An empty `result`
+    // discards the return value. Nested calls stack their arguments above
+    // this call's.
+    Operand lowerCall(Operand callee, uint32_t firstArgument, Operand result) {
+        size_t base = arguments.size();
+        for (uint32_t a = firstArgument; a != NONE; a = node(a).next) {
+            Operand argument = lowerExpression(a, NO_OPERAND);
+            arguments.push_back(argument);
         }
+        return emitCall(callee, base, result);
+    }
 
-        static const unordered_map<string, TokenType> keywords = {
-            {"if", IF}, {"else", ELSE},   {"while", WHILE}, {"for", FOR}, {"return", RETURN},
-            {"int", INT}, {"float", FLOAT}, {"double", DOUBLE},
-            {"char", CHAR}, {"string", STRING}, {"void", VOID},
-            {"break", BREAK}, {"continue", CONTINUE}, {"switch", SWITCH},
-            {"case", CASE}, {"default", DEFAULT}, {"public", PUBLIC},
-            {"private", PRIVATE}, {"protected", PROTECTED}, {"try", TRY},
-            {"catch", CATCH}, {"throw", THROW} ,{"struct", STRUCT } 
-        };
+    // Passes the arguments from `base` up and calls.
+    Operand emitCall(Operand callee, size_t base, Operand result) {
+        for (size_t a = base; a < arguments.size(); ++a) emit(TAC_PARAM, arguments[a], NO_OPERAND, NO_OPERAND);
+        emit(TAC_CALL, callee, Operand::integerConstant(arguments.size() - base), result);
+        arguments.resize(base);
+        return result;
+    }
 
-        auto it = keywords.find(identifier);
-        if (it != keywords.end()) {
-            return {it->second, identifier, line, column};
-        } else {
-            string value = "";
-            if (!tokens.empty() && tokens.back().type == ASSIGN) {
-                value = tokens.back().value; // Capture last assigned value
-            }
-            string type = !tokens.empty() && (
-                tokens.back().type == INT || tokens.back().type == FLOAT || 
-                tokens.back().type == DOUBLE || tokens.back().type == CHAR || 
-                tokens.back().type == STRING || tokens.back().type == VOID ||
-                tokens.back().type == TRY || tokens.back().type == CATCH ||
-                tokens.back().type == THROW || tokens.back().type == BREAK ||
-                tokens.back().type == CONTINUE || tokens.back().type == SWITCH ||
-                tokens.back().type == DEFAULT || tokens.back().type == CASE ||
-                tokens.back().type == PUBLIC || tokens.back().type == PRIVATE ||
-                tokens.back().type == PROTECTED) 
-                ? tokens.back().value : "";
-            symbolTable.addEntry(identifier, type, value, currentScope, line);
-            return {IDENTIFIER, identifier, line, column};
-        }    
+    // Jumps to `label` when the condition is `when`, and falls through
+    // otherwise. A constant condition is either a goto or nothing.
+    void branch(uint32_t i, Operand label, bool when) {
+        const SyntaxNode &condition = node(i);
+        if (condition.kind == SYNTAX_UNARY && condition.op == TAC_NOT) {
+            branch(condition.child[0], label, !when);
+            return;
         }
-
-    Token tokenizeStringLiteral() {
-        string literal;
-        while (!isAtEnd() && source[current] != '"') {
-            if (source[current] == '\\' && !isAtEnd()) {
-                // Handle escape characters
-                char escaped = advance();
-                switch (escaped) {
-                    case 'n': literal += '\n'; break;
-                    case 't': literal += '\t'; break;
-                    case '\\': literal += '\\'; break;
-                    case '"': literal += '"'; break;
-                    default: literal += escaped; break;
-                }
+        if (condition.kind == SYNTAX_BINARY && (condition.op == TAC_AND || condition.op == TAC_OR)) {
+            // The left operand decides a && b when false, a || b when true.
+            bool decides = condition.op == TAC_OR;
+            if (when == decides) {
+                branch(condition.child[0], label, when);
+                branch(condition.child[1], label, when);
             } else {
-                literal += advance();
+                Operand skip = newLabel();
+                branch(condition.child[0], skip, decides);
+                branch(condition.child[1], label, when);
+                emitLabel(skip);
             }
+            return;
         }
+        branchOn(lowerExpression(i, NO_OPERAND), label, when);
+    }
 
-        if (isAtEnd()) {
-            // Handle unterminated string literal
-            return {UNKNOWN, "", line, column};
+    void branchOn(Operand value, Operand label, bool when) {
+        if (value.kind == OPERAND_INTEGER) {
+            if ((value.integer != 0) == when) emitGoto(label);
+            return;
         }
-
-        advance();  // Skip the closing quote
-        return {STRING_LITERAL, literal, line, column};
+        emit(when ? TAC_IF : TAC_IF_FALSE, value, NO_OPERAND, label);
     }
-};
 
+    // EXPLICIT_STACK mode. lowerStatement, lowerEffect, lowerExpression,
+    // lowerAssignment, lowerCall and branch are folded into one loop over
+    // lowerFrames: starting a node either finishes it at once or pushes a
+    // frame and starts a child, and a finished child's value is handed to
+    // the frame on top. The code emitted at each step is shared with the
+    // recursive mode, and labels and temporaries are taken in the same
+    // order, so the code is the same.
 
-class IntermediateCodeGenerator {
-public:
-    struct ThreeAddressCode {
-        string op;
-        string arg1;
-        string arg2;
-        string result;
+    enum LowerState : uint8_t {
+        BLOCK_NEXT,        // After the statement at cursor
+        DECLARATION_NEXT,  // After the variable at cursor
+        IF_CONDITION,      // a: the else label
+        IF_THEN,
+        IF_ELSE,           // b: the end label
+        WHILE_CONDITION,   // a: top, b: end
+        WHILE_BODY,
+        FOR_INIT,
+        FOR_CONDITION,     // a: top, b: step, c: end
+        FOR_BODY,
+        FOR_STEP,
+        SWITCH_VALUE,
+        SWITCH_TEST,       // a: the value, b: end, c: the fallback; cursor: the case tested
+        SWITCH_BODY,
+        RETURN_VALUE,
+        TRY_BODY,          // a: the handler label, b: end
+        TRY_HANDLER,
+        THROW_UNHANDLED,
+        THROW_HANDLED,     // a: the handler label
+        EFFECT_POSTFIX,
+        EFFECT_CALL,
+        MEMBER_OBJECT,     // a: the target, in this and the expression states below
+        LOGICAL_JUMPS,     // b: the result, c: its label
+        BINARY_LEFT,
+        BINARY_RIGHT,      // b: the left operand
+        UNARY_OPERAND,
+        STORE_POINTER,
+        STORE_VALUE,       // b: the pointer
+        ASSIGN_VARIABLE,
+        ASSIGN_VALUE,      // b: the variable
+        POSTFIX_VARIABLE,
+        CALL_CALLEE,
+        CALL_ARGUMENTS,    // a: the callee, b: the result; cursor: the argument
+        BRANCH_BOTH,       // a && b or a || b, after the left: a: the label
+        BRANCH_LEFT,       // b: the label skipping the right
+        BRANCH_RIGHT,
+        BRANCH_VALUE       // a: the label
+    };
 
-        string toString() const {
-            if (arg2.empty()) {
-                return result + " = " + arg1;
-            }
-            return result + " = " + arg1 + " " + op + " " + arg2;
-        }
+    struct LowerFrame {
+        LowerState state;
+        bool when;  // Of a branch
+        uint32_t node;
+        uint32_t cursor;
+        size_t base;  // Of the frame's cases or arguments
+        Operand a, b, c;
     };
 
-    vector<ThreeAddressCode> generate(const vector<Token>& tokens) {
-        vector<ThreeAddressCode> intermediateCode;
-        stack<string> loopLabels;  // To handle loops (continue, break)
-        string switchLabel;        // To handle switch-case
+    ArenaVector<LowerFrame> lowerFrames;
+    ArenaVector<uint32_t> caseSearch;  // Statements collectCases has still to look at
 
-        for (size_t i = 0; i < tokens.size(); ++i) {
-            if (tokens[i].type == IDENTIFIER && i + 1 < tokens.size() && tokens[i + 1].type == ASSIGN) {
-                // Assignment handling
-                if (i + 2 < tokens.size()) {
-                    intermediateCode.push_back({"=", tokens[i + 2].value, "", tokens[i].value});
-                }
-            }
+    LowerFrame &pushFrame(LowerState state, uint32_t i, Operand a = NO_OPERAND, Operand b = NO_OPERAND,
+                          Operand c = NO_OPERAND) {
+        lowerFrames.push_back({state, false, i, NONE, 0, a, b, c});
+        return lowerFrames.back();
+    }
 
-            // Handle arithmetic operations (existing)
-            if (tokens[i].type == PLUS || tokens[i].type == MINUS ||
-                tokens[i].type == MULTIPLY || tokens[i].type == DIVIDE) {
-                if (i > 0 && i + 1 < tokens.size()) {
-                    intermediateCode.push_back({tokenTypeToString(tokens[i].type),
-                                                tokens[i - 1].value,
-                                                tokens[i + 1].value,
-                                                "temp" + to_string(intermediateCode.size())});
+    // lowerStatement(first), with lowerFrames for the native stack.
+    void lowerWithFrames(uint32_t first) {
+        enum Step { STATEMENT, EFFECT, EXPRESSION, BRANCH, CALL, FINISHED };
+        Step step = STATEMENT;
+        uint32_t i = first;           // The node to start; CALL: the first argument
+        Operand target = NO_OPERAND;  // EXPRESSION: the target; BRANCH: the label; CALL: the result
+        Operand callee = NO_OPERAND;  // CALL
+        bool when = false;            // BRANCH
+        Operand value = NO_OPERAND;   // FINISHED: the value of the finished node
+        size_t bottom = lowerFrames.size();
+        for (;;) {
+            switch (step) {
+                case STATEMENT: {  // lowerStatement
+                    const SyntaxNode &statement = node(i);
+                    step = FINISHED;
+                    value = NO_OPERAND;
+                    switch (statement.kind) {
+                        case SYNTAX_BLOCK:
+                            if (statement.child[0] != NONE) {
+                                pushFrame(BLOCK_NEXT, i).cursor = statement.child[0];
+                                i = statement.child[0];
+                                step = STATEMENT;
+                            }
+                            break;
+                        case SYNTAX_DECLARATION:
+                            pushFrame(DECLARATION_NEXT, i);
+                            break;
+                        case SYNTAX_EXPRESSION:
+                            i = statement.child[0];
+                            step = EFFECT;
+                            break;
+                        case SYNTAX_IF:
+                            pushFrame(IF_CONDITION, i, newLabel());
+                            target = lowerFrames.back().a;
+                            i = statement.child[0];
+                            when = false;
+                            step = BRANCH;
+                            break;
+                        case SYNTAX_WHILE: {
+                            Operand top = newLabel(), end = newLabel();
+                            emitLabel(top);
+                            pushFrame(WHILE_CONDITION, i, top, end);
+                            target = end;
+                            i = statement.child[0];
+                            when = false;
+                            step = BRANCH;
+                            break;
+                        }
+                        case SYNTAX_FOR:
+                            pushFrame(FOR_INIT, i);
+                            if (statement.child[0] != NONE) {
+                                i = statement.child[0];
+                                step = STATEMENT;
+                            }
+                            break;
+                        case SYNTAX_SWITCH:
+                            pushFrame(SWITCH_VALUE, i);
+                            i = statement.child[0];
+                            target = NO_OPERAND;
+                            step = EXPRESSION;
+                            break;
+                        case SYNTAX_CASE:
+                        case SYNTAX_DEFAULT: lowerCaseLabel(i); break;
+                        case SYNTAX_BREAK:
+                            if (!breakLabels.empty()) emitGoto(breakLabels.back());
+                            break;
+                        case SYNTAX_CONTINUE:
+                            if (!continueLabels.empty()) emitGoto(continueLabels.back());
+                            break;
+                        case SYNTAX_RETURN:
+                            pushFrame(RETURN_VALUE, i);
+                            if (statement.child[0] != NONE) {
+                                i = statement.child[0];
+                                target = NO_OPERAND;
+                                step = EXPRESSION;
+                            }
+                            break;
+                        case SYNTAX_TRY: {
+                            Operand handlerLabel = newLabel(), end = newLabel();
+                            pushHandler(statement, handlerLabel);
+                            pushFrame(TRY_BODY, i, handlerLabel, end);
+                            i = statement.child[0];
+                            step = STATEMENT;
+                            break;
+                        }
+                        case SYNTAX_THROW:
+                            i = statement.child[0];
+                            step = EXPRESSION;
+                            if (handlers.empty()) {
+                                pushFrame(THROW_UNHANDLED, i);
+                                target = NO_OPERAND;
+                            } else {
+                                pushFrame(THROW_HANDLED, i, handlers.back().label);
+                                target = handlers.back().parameter;
+                                if (target.empty()) step = EFFECT;
+                            }
+                            break;
+                        default: break;
+                    }
+                    continue;
                 }
-            }
-
-            // Handle control flow (break, continue)
-            if (tokens[i].type == BREAK) {
-                string breakLabel = "break" + to_string(intermediateCode.size());
-                intermediateCode.push_back({"goto", "", "", breakLabel});
-            } 
-            else if (tokens[i].type == CONTINUE) {
-                string continueLabel = "continue" + to_string(intermediateCode.size());
-                intermediateCode.push_back({"goto", "", "", continueLabel});
-            }
-
-            // Handle switch-case
-            if (tokens[i].type == SWITCH) {
-                switchLabel = "switch" + to_string(intermediateCode.size());
-                intermediateCode.push_back({"switch", "", "", switchLabel});
-            }
-
-            if (tokens[i].type == CASE) {
-                if (!switchLabel.empty()) {
-                    intermediateCode.push_back({"case", tokens[i + 1].value, "", switchLabel});
+                case EFFECT: {  // lowerEffect
+                    const SyntaxNode &expression = node(i);
+                    target = NO_OPERAND;
+                    if (expression.kind == SYNTAX_POSTFIX || expression.kind == SYNTAX_CALL) {
+                        pushFrame(expression.kind == SYNTAX_POSTFIX ? EFFECT_POSTFIX : EFFECT_CALL, i);
+                        i = expression.child[0];
+                    }
+                    step = EXPRESSION;
+                    continue;
                 }
+                case EXPRESSION: {  // lowerExpression and lowerAssignment
+                    const SyntaxNode &expression = node(i);
+                    step = EXPRESSION;
+                    switch (expression.kind) {
+                        case SYNTAX_MEMBER: pushFrame(MEMBER_OBJECT, i, target); break;
+                        case SYNTAX_BINARY:
+                            if (expression.op == TAC_AND || expression.op == TAC_OR) {
+                                Operand result = newTemp(), done = newLabel();
+                                emit(TAC_ASSIGN, Operand::integerConstant(0), NO_OPERAND, result);
+                                pushFrame(LOGICAL_JUMPS, i, target, result, done);
+                                target = done;
+                                when = false;
+                                step = BRANCH;
+                                continue;
+                            }
+                            pushFrame(BINARY_LEFT, i, target);
+                            break;
+                        case SYNTAX_UNARY: pushFrame(UNARY_OPERAND, i, target); break;
+                        case SYNTAX_ASSIGN: {
+                            const SyntaxNode &assigned = node(expression.child[0]);
+                            if (assigned.kind == SYNTAX_UNARY && assigned.op == TAC_DEREF) {
+                                pushFrame(STORE_POINTER, i, target);
+                                i = assigned.child[0];
+                                target = NO_OPERAND;
+                                continue;
+                            }
+                            pushFrame(ASSIGN_VARIABLE, i, target);
+                            break;
+                        }
+                        case SYNTAX_POSTFIX: pushFrame(POSTFIX_VARIABLE, i, target); break;
+                        case SYNTAX_CALL: pushFrame(CALL_CALLEE, i, target); break;
+                        default:
+                            value = assignTo(leafValue(expression), target);
+                            step = FINISHED;
+                            continue;
+                    }
+                    i = expression.child[0];
+                    target = NO_OPERAND;
+                    continue;
+                }
+                case BRANCH: {  // branch
+                    const SyntaxNode &condition = node(i);
+                    if (condition.kind == SYNTAX_UNARY && condition.op == TAC_NOT) {
+                        i = condition.child[0];
+                        when = !when;
+                        continue;
+                    }
+                    if (condition.kind == SYNTAX_BINARY && (condition.op == TAC_AND || condition.op == TAC_OR)) {
+                        bool decides = condition.op == TAC_OR;
+                        if (when == decides) {
+                            pushFrame(BRANCH_BOTH, i, target).when = when;
+                        } else {
+                            Operand skip = newLabel();
+                            pushFrame(BRANCH_LEFT, i, target, skip).when = when;
+                            target = skip;
+                            when = decides;
+                        }
+                        i = condition.child[0];
+                        continue;
+                    }
+                    pushFrame(BRANCH_VALUE, i, target).when = when;
+                    target = NO_OPERAND;
+                    step = EXPRESSION;
+                    continue;
+                }
+                case CALL: {  // lowerCall
+                    if (i == NONE) {
+                        value = emitCall(callee, arguments.size(), target);
+                        step = FINISHED;
+                        continue;
+                    }
+                    LowerFrame &call = pushFrame(CALL_ARGUMENTS, i, callee, target);
+                    call.cursor = i;
+                    call.base = arguments.size();
+                    target = NO_OPERAND;
+                    step = EXPRESSION;
+                    continue;
+                }
+                case FINISHED:
+                    break;
             }
 
-            // Handle reference operator (&)
-            if (tokens[i].type == AND) {
-                intermediateCode.push_back({"&", tokens[i + 1].value, "", tokens[i].value});
-            }
-
-            // Handle dereferencing operator (*)
-            if (tokens[i].type == DEREFERENCE) {
-                intermediateCode.push_back({"*", tokens[i + 1].value, "", tokens[i].value});
+            // Hands `value` to the frame on top, which either starts its next
+            // child or finishes too.
+            if (lowerFrames.size() == bottom) return;
+            LowerFrame &frame = lowerFrames.back();
+            const SyntaxNode &current = node(frame.node);
+            switch (frame.state) {
+                case BLOCK_NEXT:
+                    frame.cursor = node(frame.cursor).next;
+                    if (frame.cursor != NONE) {
+                        i = frame.cursor;
+                        step = STATEMENT;
+                        continue;
+                    }
+                    break;
+                case DECLARATION_NEXT: {
+                    // lowerVariable, for each variable with a value.
+                    frame.cursor = frame.cursor == NONE ? current.child[0] : node(frame.cursor).next;
+                    while (frame.cursor != NONE && node(frame.cursor).child[0] == NONE &&
+                           node(frame.cursor).child[1] == NONE) {
+                        frame.cursor = node(frame.cursor).next;
+                    }
+                    if (frame.cursor == NONE) break;
+                    const SyntaxNode &variable = node(frame.cursor);
+                    target = {OPERAND_NAME, variable.name};
+                    if (variable.child[0] == NONE && current.op == IDENTIFIER) {
+                        callee = {OPERAND_NAME, current.name};
+                        i = variable.child[1];
+                        step = CALL;
+                    } else {
+                        i = variable.child[0] != NONE ? variable.child[0] : variable.child[1];
+                        step = EXPRESSION;
+                    }
+                    continue;
+                }
+                case IF_CONDITION:
+                    frame.state = IF_THEN;
+                    i = current.child[1];
+                    step = STATEMENT;
+                    continue;
+                case IF_THEN:
+                    if (current.child[2] == NONE) {
+                        emitLabel(frame.a);
+                        break;
+                    }
+                    frame.b = newLabel();
+                    emitGoto(frame.b);
+                    emitLabel(frame.a);
+                    frame.state = IF_ELSE;
+                    i = current.child[2];
+                    step = STATEMENT;
+                    continue;
+                case IF_ELSE: emitLabel(frame.b); break;
+                case WHILE_CONDITION:
+                    breakLabels.push_back(frame.b);
+                    continueLabels.push_back(frame.a);
+                    frame.state = WHILE_BODY;
+                    i = current.child[1];
+                    step = STATEMENT;
+                    continue;
+                case WHILE_BODY:
+                    breakLabels.pop_back();
+                    continueLabels.pop_back();
+                    emitGoto(frame.a);
+                    emitLabel(frame.b);
+                    break;
+                case FOR_INIT:
+                    frame.a = newLabel();
+                    frame.b = newLabel();
+                    frame.c = newLabel();
+                    emitLabel(frame.a);
+                    frame.state = FOR_CONDITION;
+                    if (current.child[1] != NONE) {
+                        i = current.child[1];
+                        target = frame.c;
+                        when = false;
+                        step = BRANCH;
+                    }
+                    continue;
+                case FOR_CONDITION:
+                    breakLabels.push_back(frame.c);
+                    continueLabels.push_back(frame.b);
+                    frame.state = FOR_BODY;
+                    i = current.child[2];
+                    step = STATEMENT;
+                    continue;
+                case FOR_BODY:
+                    breakLabels.pop_back();
+                    continueLabels.pop_back();
+                    emitLabel(frame.b);
+                    frame.state = FOR_STEP;
+                    if (current.extra != NONE) {
+                        i = current.extra;
+                        step = EFFECT;
+                    }
+                    continue;
+                case FOR_STEP:
+                    emitGoto(frame.a);
+                    emitLabel(frame.c);
+                    break;
+                case SWITCH_VALUE:
+                case SWITCH_TEST:
+                    // lowerSwitch's loop over the cases, then the body.
+                    if (frame.state == SWITCH_VALUE) {
+                        frame.a = value;
+                        frame.base = switchCases.size();
+                        collectCases(current.child[1]);
+                        frame.b = frame.c = newLabel();
+                        frame.cursor = frame.base;
+                        frame.state = SWITCH_TEST;
+                    } else {
+                        testCase(frame.a, value, switchCases[frame.cursor].second);
+                        frame.cursor++;
+                    }
+                    for (; frame.cursor < switchCases.size(); ++frame.cursor) {
+                        const SyntaxNode &label = node(switchCases[frame.cursor].first);
+                        if (label.kind != SYNTAX_DEFAULT) break;
+                        frame.c = switchCases[frame.cursor].second;
+                    }
+                    if (frame.cursor < switchCases.size()) {
+                        i = node(switchCases[frame.cursor].first).child[0];
+                        target = NO_OPERAND;
+                        step = EXPRESSION;
+                        continue;
+                    }
+                    emitGoto(frame.c);
+                    switchStarts.push_back(frame.base);
+                    breakLabels.push_back(frame.b);
+                    frame.state = SWITCH_BODY;
+                    i = current.child[1];
+                    step = STATEMENT;
+                    continue;
+                case SWITCH_BODY:
+                    breakLabels.pop_back();
+                    switchStarts.pop_back();
+                    switchCases.resize(frame.base);
+                    emitLabel(frame.b);
+                    break;
+                case RETURN_VALUE: emit(TAC_RETURN, value, NO_OPERAND, NO_OPERAND); break;
+                case TRY_BODY:
+                    handlers.pop_back();
+                    emitGoto(frame.b);
+                    emitLabel(frame.a);
+                    frame.state = TRY_HANDLER;
+                    if (current.child[1] != NONE) {
+                        i = node(current.child[1]).child[1];
+                        step = STATEMENT;
+                    }
+                    continue;
+                case TRY_HANDLER: emitLabel(frame.b); break;
+                case THROW_UNHANDLED: emitThrow(value); break;
+                case THROW_HANDLED: emitGoto(frame.a); break;
+                case EFFECT_POSTFIX: emit((TacOp)current.op, value, Operand::integerConstant(1), value); break;
+                case EFFECT_CALL:
+                case CALL_CALLEE:
+                    callee = value;
+                    target = frame.state == EFFECT_CALL ? NO_OPERAND : frame.a.empty() ? newTemp() : frame.a;
+                    i = current.child[1];
+                    lowerFrames.pop_back();
+                    step = CALL;
+                    continue;
+                case MEMBER_OBJECT: value = memberValue(current, value, frame.a); break;
+                case LOGICAL_JUMPS:
+                    emit(TAC_ASSIGN, Operand::integerConstant(1), NO_OPERAND, frame.b);
+                    emitLabel(frame.c);
+                    value = assignTo(frame.b, frame.a);
+                    break;
+                case BINARY_LEFT:
+                    frame.b = value;
+                    frame.state = BINARY_RIGHT;
+                    i = current.child[1];
+                    target = NO_OPERAND;
+                    step = EXPRESSION;
+                    continue;
+                case BINARY_RIGHT: value = binaryValue((TacOp)current.op, frame.b, value, frame.a); break;
+                case UNARY_OPERAND: value = unaryValue((TacOp)current.op, value, frame.a); break;
+                case STORE_POINTER:
+                    frame.b = value;
+                    frame.state = STORE_VALUE;
+                    i = current.child[1];
+                    target = NO_OPERAND;
+                    step = EXPRESSION;
+                    continue;
+                case STORE_VALUE: value = assignTo(store((TacOp)current.op, frame.b, value), frame.a); break;
+                case ASSIGN_VARIABLE:
+                    frame.b = value;
+                    frame.state = ASSIGN_VALUE;
+                    i = current.child[1];
+                    target = current.op == TAC_ASSIGN ? value : NO_OPERAND;
+                    step = EXPRESSION;
+                    continue;
+                case ASSIGN_VALUE:
+                    if (current.op != TAC_ASSIGN) {
+                        emit((TacOp)current.op, frame.b, value, frame.b);
+                        value = frame.b;
+                    }
+                    value = assignTo(value, frame.a);
+                    break;
+                case POSTFIX_VARIABLE: value = postfixValue((TacOp)current.op, value, frame.a); break;
+                case CALL_ARGUMENTS:
+                    arguments.push_back(value);
+                    frame.cursor = node(frame.cursor).next;
+                    if (frame.cursor != NONE) {
+                        i = frame.cursor;
+                        target = NO_OPERAND;
+                        step = EXPRESSION;
+                        continue;
+                    }
+                    value = emitCall(frame.a, frame.base, frame.b);
+                    break;
+                case BRANCH_BOTH:
+                    i = current.child[1];
+                    target = frame.a;
+                    when = frame.when;
+                    lowerFrames.pop_back();
+                    step = BRANCH;
+                    continue;
+                case BRANCH_LEFT:
+                    frame.state = BRANCH_RIGHT;
+                    i = current.child[1];
+                    target = frame.a;
+                    when = frame.when;
+                    step = BRANCH;
+                    continue;
+                case BRANCH_RIGHT: emitLabel(frame.b); break;
+                case BRANCH_VALUE: branchOn(value, frame.a, frame.when); break;
             }
+            lowerFrames.pop_back();
+            step = FINISHED;
         }
+    }
 
-        return intermediateCode;
+    // Folds integer constant arithmetic and comparisons; returns false if it
+    // cannot. Results stay non-negative, as literals are.
+    static bool fold(TacOp op, const Operand &left, const Operand &right, Operand &result) {
+        if (left.kind != OPERAND_INTEGER || right.kind != OPERAND_INTEGER) return false;
+        uint64_t a = left.integer, b = right.integer;
+        switch (op) {
+            case TAC_ADD: result = Operand::integerConstant(a + b); return true;
+            case TAC_SUB:
+                if (a < b) return false;
+                result = Operand::integerConstant(a - b);
+                return true;
+            case TAC_MUL: result = Operand::integerConstant(a * b); return true;
+            case TAC_DIV:
+            case TAC_MOD:
+                if (b == 0) return false;
+                result = Operand::integerConstant(op == TAC_DIV ? a / b : a % b);
+                return true;
+            case TAC_SHL:
+            case TAC_SHR:
+                if (b >= 64) return false;
+                result = Operand::integerConstant(op == TAC_SHL ? a << b : a >> b);
+                return true;
+            case TAC_EQ: result = Operand::integerConstant(a == b); return true;
+            case TAC_NE: result = Operand::integerConstant(a != b); return true;
+            case TAC_LT: result = Operand::integerConstant(a < b); return true;
+            case TAC_GT: result = Operand::integerConstant(a > b); return true;
+            case TAC_LE: result = Operand::integerConstant(a <= b); return true;
+            case TAC_GE: result = Operand::integerConstant(a >= b); return true;
+            default: return false;
+        }
     }
+};
 
-private:
-    string tokenTypeToString(TokenType type) {
-        switch (type) {
-        case PLUS: return "+";
-        case MINUS: return "-";
-        case MULTIPLY: return "*";
-        case DIVIDE: return "/";
-        case 'AND': return "&";
-        case DEREFERENCE: return "*";
-        default: return "?";
+// An operand as assembly text: names and temporaries as they are, labels as
+// local ".L" labels, integer constants in decimal and floating ones as their
+// IEEE bit pattern (there is no floating immediate). Written with operator<<.
+struct AsmOperand {
+    const Operand &operand;
+    const Interner &interner;
+
+    template <typename Out>
+    void format(Out &out) const {
+        uint64_t bits;
+        if (operand.kind == OPERAND_FLOAT) {
+            float value = (float)operand.real;
+            uint32_t floatBits;
+            memcpy(&floatBits, &value, sizeof(floatBits));
+            bits = floatBits;
+        } else if (operand.kind == OPERAND_DOUBLE) {
+            memcpy(&bits, &operand.real, sizeof(bits));
+        } else {
+            if (operand.kind == OPERAND_LABEL) out << '.';
+            operand.format(out, interner);
+            return;
         }
+        char text[24];
+        out << "0x" << string_view(text, to_chars(text, text + sizeof(text), bits, 16).ptr - text);
     }
 };
 
+inline ostream &operator<<(ostream &out, const AsmOperand &operand) {
+    operand.format(out);
+    return out;
+}
+
+inline DumpWriter &operator<<(DumpWriter &out, const AsmOperand &operand) {
+    operand.format(out);
+    return out;
+}
+
 class AssemblyGenerator {
 public:
-    string generate(const vector<IntermediateCodeGenerator::ThreeAddressCode>& intermediateCode) {
+    explicit AssemblyGenerator(const Interner &interner) : interner(interner) {}
+
+    string generate(const IntermediateCodeGenerator::Code& intermediateCode) {
         stringstream assembly;
+        generate(intermediateCode, assembly);
+        return assembly.str();
+    }
+
+    // Writes the assembly to an ostream or DumpWriter.
+    template <typename Out>
+    void generate(const IntermediateCodeGenerator::Code& intermediateCode, Out &assembly) {
         assembly << ".intel_syntax noprefix\n";
-        assembly << ".global main\n\n";
-        assembly << "main:\n";
-        assembly << "    push rbp\n";
-        assembly << "    mov rbp, rsp\n\n";
+        assembly << ".global main\n";
 
         for (const auto& code : intermediateCode) {
+            if (code.op == TAC_FUNCTION) assembly << "\n";
             generateInstruction(code, assembly);
         }
+    }
 
-        assembly << "    mov rax, 0\n";
-        assembly << "    leave\n";
-        assembly << "    ret\n";
+private:
+    const Interner &interner;
 
-        return assembly.str();
+    AsmOperand text(const Operand &operand) const {
+        return {operand, interner};
     }
 
-private:
-    void generateInstruction(const IntermediateCodeGenerator::ThreeAddressCode& code, stringstream& assembly) {
-        if (code.op == "=") {
-            assembly << "    # Assignment\n";
-            assembly << "    mov rax, " << code.arg1 << "\n";
-            assembly << "    mov [" << code.result << "], rax\n";
-        }
-        else if (code.op == "+") {
-            assembly << "    # Addition\n";
-            assembly << "    mov rax, " << code.arg1 << "\n";
-            assembly << "    add rax, " << code.arg2 << "\n";
-            assembly << "    mov [" << code.result << "], rax\n";
+    // rax = arg1 op arg2, stored to result. Division and shifts take their
+    // second operand in rcx.
+    template <typename Out>
+    void generateBinary(const IntermediateCodeGenerator::ThreeAddressCode& code, Out& assembly) {
+        static const char *const setInstructions[] = {"sete", "setne", "setl", "setg", "setle", "setge"};
+        assembly << "    mov rax, " << text(code.arg1) << "\n";
+        switch (code.op) {
+        case TAC_ADD: assembly << "    add rax, " << text(code.arg2) << "\n"; break;
+        case TAC_SUB: assembly << "    sub rax, " << text(code.arg2) << "\n"; break;
+        case TAC_MUL: assembly << "    imul rax, " << text(code.arg2) << "\n"; break;
+        case TAC_DIV:
+        case TAC_MOD:
+            assembly << "    cqo\n";
+            assembly << "    mov rcx, " << text(code.arg2) << "\n";
+            assembly << "    idiv rcx\n";
+            if (code.op == TAC_MOD) assembly << "    mov rax, rdx\n";
+            break;
+        case TAC_SHL:
+        case TAC_SHR:
+            assembly << "    mov rcx, " << text(code.arg2) << "\n";
+            assembly << (code.op == TAC_SHL ? "    shl rax, cl\n" : "    sar rax, cl\n");
+            break;
+        default:
+            assembly << "    cmp rax, " << text(code.arg2) << "\n";
+            assembly << "    " << setInstructions[code.op - TAC_EQ] << " al\n";
+            assembly << "    movzx rax, al\n";
+            break;
         }
-        else if (code.op == "*") {
+        assembly << "    mov [" << text(code.result) << "], rax\n";
+    }
+
+    template <typename Out>
+    void generateInstruction(const IntermediateCodeGenerator::ThreeAddressCode& code, Out& assembly) {
+        switch (code.op) {
+        case TAC_FUNCTION:
+            assembly << text(code.result) << ":\n";
+            assembly << "    push rbp\n";
+            assembly << "    mov rbp, rsp\n\n";
+            break;
+        case TAC_END:
+            assembly << "    mov rax, 0\n";
+            assembly << "    leave\n";
+            assembly << "    ret\n";
+            break;
+        case TAC_RETURN:
+            assembly << "    # Return\n";
+            if (!code.arg1.empty()) assembly << "    mov rax, " << text(code.arg1) << "\n";
+            assembly << "    leave\n";
+            assembly << "    ret\n";
+            break;
+        case TAC_ASSIGN:
+            assembly << "    # Assignment\n";
+            assembly << "    mov rax, " << text(code.arg1) << "\n";
+            assembly << "    mov [" << text(code.result) << "], rax\n";
+            break;
+        case TAC_ADD:
+        case TAC_SUB:
+        case TAC_MUL:
+        case TAC_DIV:
+        case TAC_MOD:
+        case TAC_SHL:
+        case TAC_SHR:
+            assembly << "    # Arithmetic (" << tacOpSymbol(code.op) << ")\n";
+            generateBinary(code, assembly);
+            break;
+        case TAC_EQ:
+        case TAC_NE:
+        case TAC_LT:
+        case TAC_GT:
+        case TAC_LE:
+        case TAC_GE:
+            assembly << "    # Comparison (" << tacOpSymbol(code.op) << ")\n";
+            generateBinary(code, assembly);
+            break;
+        case TAC_NEG:
+            assembly << "    # Negation\n";
+            assembly << "    mov rax, " << text(code.arg1) << "\n";
+            assembly << "    neg rax\n";
+            assembly << "    mov [" << text(code.result) << "], rax\n";
+            break;
+        case TAC_NOT:
+            assembly << "    # Logical not\n";
+            assembly << "    mov rax, " << text(code.arg1) << "\n";
+            assembly << "    cmp rax, 0\n";
+            assembly << "    sete al\n";
+            assembly << "    movzx rax, al\n";
+            assembly << "    mov [" << text(code.result) << "], rax\n";
+            break;
+        case TAC_DEREF:
             assembly << "    # Dereferencing pointer\n";
-            assembly << "    mov rax, [" << code.arg1 << "]\n";
-            assembly << "    mov [" << code.result << "], rax\n";
-        }
-        else if (code.op == "&") {
+            assembly << "    mov rax, " << text(code.arg1) << "\n";
+            assembly << "    mov rax, [rax]\n";
+            assembly << "    mov [" << text(code.result) << "], rax\n";
+            break;
+        case TAC_ADDRESS:
             assembly << "    # Getting reference (address)\n";
-            assembly << "    lea rax, [" << code.arg1 << "]\n";
-            assembly << "    mov [" << code.result << "], rax\n";
-        }
-        else if (code.op == "goto") {
+            assembly << "    lea rax, [" << text(code.arg1) << "]\n";
+            assembly << "    mov [" << text(code.result) << "], rax\n";
+            break;
+        case TAC_STORE:
+            assembly << "    # Store through pointer\n";
+            assembly << "    mov rax, " << text(code.arg1) << "\n";
+            assembly << "    mov rcx, " << text(code.result) << "\n";
+            assembly << "    mov [rcx], rax\n";
+            break;
+        case TAC_LABEL:
+            assembly << text(code.result) << ":\n";
+            break;
+        case TAC_GOTO:
             assembly << "    # Jump instruction\n";
-            assembly << "    jmp " << code.result << "\n";
-        }
-        else if (code.op == "switch") {
-            assembly << "    # Switch statement\n";
-            assembly << code.result << ":\n";
-        }
-        else if (code.op == "case") {
-            assembly << "    # Case label\n";
-            assembly << "    cmp rax, " << code.arg1 << "\n";
-            assembly << "    je " << code.result << "\n";
+            assembly << "    jmp " << text(code.result) << "\n";
+            break;
+        case TAC_IF:
+        case TAC_IF_FALSE:
+            assembly << "    # Conditional jump\n";
+            assembly << "    mov rax, " << text(code.arg1) << "\n";
+            assembly << "    cmp rax, 0\n";
+            assembly << (code.op == TAC_IF ? "    jne " : "    je ") << text(code.result) << "\n";
+            break;
+        case TAC_PARAM:
+            assembly << "    # Argument\n";
+            assembly << "    mov rax, " << text(code.arg1) << "\n";
+            assembly << "    push rax\n";
+            break;
+        case TAC_CALL:
+            assembly << "    # Call\n";
+            assembly << "    call " << text(code.arg1) << "\n";
+            if (code.arg2.integer) assembly << "    add rsp, " << code.arg2.integer * 8 << "\n";
+            if (!code.result.empty()) assembly << "    mov [" << text(code.result) << "], rax\n";
+            break;
+        default:
+            break;
         }
     }
 };
 
+// Per-phase statistics printed by Kabir_ka_Compiler::compile, to stderr.
+enum StatsOutput {
+    STATS_OFF,
+    STATS_TABLE,
+    STATS_JSON
+};
+
 // Compiler Class
 class Kabir_ka_Compiler {
 public:
-    void compile(const string &sourceCode) {
-        Lexer lexer(sourceCode);
-        vector<Token> tokens = lexer.tokenize();
+    // Compiles a file without copying it: regular files are memory-mapped and
+    // the lexer scans the mapping directly. "-" reads standard input.
+    bool compileFile(const string &path) {
+        MappedFile file(path);
+        return compile(file.view());
+    }
+
+    // Threads used for lexing; more than one splits the source into chunks.
+    size_t lexerThreads = 1;
+
+    // Threads used for parsing; more than one parses batches of top-level
+    // functions side by side (see ParallelParser). The parser then needs the
+    // whole token vector up front instead of pulling tokens as it goes.
+    // Capped at the hardware threads: on fewer cores, splitting only adds
+    // the pre-scan and the merge to a serial parse.
+    size_t parserThreads = 1;
+
+    // Back the compilation arena with huge pages where the system has them.
+    bool hugePages = false;
+
+    // Which phases compile() prints. A suppressed dump costs nothing: the
+    // tokens are not even formatted.
+    bool dumpTokens = true;
+    bool dumpSymbols = true;
+    bool dumpIntermediate = true;
+    bool dumpAssembly = true;
+    bool dumpSyntaxTree = false;  // Off by default: the tree is for debugging the parser
+
+    // EXPLICIT_STACK parses and lowers input nested deeper than the native
+    // stack allows, such as machine-generated code; the output is the same.
+    ParseMode parseMode = RECURSIVE_DESCENT;
+
+    // Directory of token caches (see common/token_cache.h); empty disables
+    // caching. A source whose cache is there is not lexed at all; otherwise
+    // the tokens are recorded while they are lexed and the cache is written
+    // after the compilation.
+    string tokenCacheDirectory;
+
+    // With statistics on, the phases run one after another instead of being
+    // pulled token by token, so each can be timed on its own: the lexer fills
+    // a token vector that the declaration pass and the parser then replay.
+    // The output is the same.
+    StatsOutput stats = STATS_OFF;
+
+    // One interner and one arena per compilation, shared by every phase. The
+    // arena holds decoded literals, the symbol table, the syntax tree and the
+    // intermediate code, and is freed in one go when compile() returns. The
+    // serial lexer is pulled token by token by the parser, so no token vector is
+    // built; the parallel lexer has to see the whole file and replays its
+    // vector instead.
+    //
+    // Returns false if there were syntax errors. They are reported on stderr,
+    // and the tree is then neither lowered nor turned into assembly.
+    bool compile(string_view sourceCode) {
+        Interner interner;
+        Arena arena(hugePages);
+        string cachePath = tokenCacheDirectory.empty() ? string() : tokenCachePath(tokenCacheDirectory, sourceCode);
+        TokenCacheFile cache;
+        bool cached = !cachePath.empty() && cache.open(cachePath, sourceCode);
+        if (stats != STATS_OFF) {
+            return compileInPhases(sourceCode, cached ? &cache : nullptr, cachePath, interner, arena);
+        } else if (parseThreads() > 1) {
+            unique_ptr<ParallelLexer> parallelLexer;
+            vector<Token> tokens = lexAll(sourceCode, cached ? &cache : nullptr, interner, arena, parallelLexer);
+            if (!cached && !cachePath.empty()) writeTokenCache(tokens, sourceCode, cachePath, interner);
+            return translateInParallel(tokens, interner, arena);
+        } else if (cached) {
+            CachedTokens tokens(cache, sourceCode, interner);
+            return translate(tokens, interner, arena);
+        } else if (lexerThreads > 1) {
+            ParallelLexer lexer(sourceCode, interner, lexerThreads);
+            vector<Token> tokens = lexer.tokenize();
+            TokenReplay replay(tokens);
+            return translateAndCache(replay, sourceCode, cachePath, interner, arena);
+        } else {
+            Lexer lexer(sourceCode, interner, &arena);
+            return translateAndCache(lexer, sourceCode, cachePath, interner, arena);
+        }
+    }
+
+private:
+    size_t parseThreads() const {
+        return min(parserThreads, ThreadPool::defaultThreads());
+    }
+
+    // Prints each token as it is pulled through, END_OF_FILE once.
+    template <typename Source>
+    class TokenEcho {
+    private:
+        Source &source;
+        DumpWriter *out;  // Null when tokens are not dumped
+        bool ended = false;
+
+    public:
+        TokenEcho(Source &source, DumpWriter *out) : source(source), out(out) {}
+
+        Token nextToken() {
+            Token token = source.nextToken();
+            if (out && !ended) {
+                token.format(*out);
+                *out << '\n';
+                ended = token.type == END_OF_FILE;
+            }
+            return token;
+        }
+    };
+
+    // Runs the symbol table's declaration pass over each token pulled through.
+    template <typename Source>
+    class DeclarationPass {
+    private:
+        Source &source;
+        SymbolTable &symbolTable;
+        bool ended = false;
+
+    public:
+        DeclarationPass(Source &source, SymbolTable &symbolTable) : source(source), symbolTable(symbolTable) {}
+
+        Token nextToken() {
+            Token token = source.nextToken();
+            if (!ended) {
+                symbolTable.observe(token);
+                ended = token.type == END_OF_FILE;
+            }
+            return token;
+        }
+    };
+
+    // Replays an already lexed token vector through the pull interface.
+    class TokenReplay {
+    private:
+        const vector<Token> &tokens;
+        size_t pos = 0;
+
+    public:
+        explicit TokenReplay(const vector<Token> &tokens) : tokens(tokens) {}
+
+        Token nextToken() {
+            return pos < tokens.size() ? tokens[pos++] : tokens.back();
+        }
+    };
+
+    // Records the tokens for the cache on the way through, if there is one.
+    template <typename Source>
+    bool translateAndCache(Source &source, string_view sourceCode, const string &cachePath, Interner &interner,
+                           Arena &arena) {
+        if (cachePath.empty()) return translate(source, interner, arena);
+        TokenCacheRecorder<Source> recorder(source, sourceCode, interner);
+        bool translated = translate(recorder, interner, arena);
+        recorder.write(cachePath);
+        return translated;
+    }
+
+    // The symbol table is complete once the parser has pulled END_OF_FILE.
+    template <typename Source>
+    bool translate(Source &source, Interner &interner, Arena &arena) {
+        SymbolTable symbolTable(interner, &arena);
+        DeclarationPass<Source> declarations(source, symbolTable);
+
+        // All dumps go through one buffer, written out in large chunks.
+        DumpWriter dump(cout);
 
         // Print tokens
-        cout << "Tokens:\n";
-        for (const auto &token : tokens) {
-            cout << token.toString() << endl;
+        if (dumpTokens) dump << "Tokens:\n";
+        TokenEcho<DeclarationPass<Source>> echo(declarations, dumpTokens ? &dump : nullptr);
+        TokenStream<TokenEcho<DeclarationPass<Source>>> tokens(echo);
+
+        // Parsing and Intermediate Code Generation
+        Parser<TokenStream<TokenEcho<DeclarationPass<Source>>>> parser(tokens, interner, &arena, parseMode);
+        SyntaxTree syntaxTree = parser.parse();
+        auto intermediateCode = lower(syntaxTree, parser.errors(), interner, arena);
+
+        PhaseStats unused;
+        return writeResults(symbolTable, syntaxTree, parser.errors(), intermediateCode, interner, dump, unused);
+    }
+
+    // translate() for a token vector parsed by ParallelParser: the tokens are
+    // dumped and declared before parsing starts rather than as it goes.
+    bool translateInParallel(const vector<Token> &tokens, Interner &interner, Arena &arena) {
+        SymbolTable symbolTable(interner, &arena);
+        DumpWriter dump(cout);
+        if (dumpTokens) dump << "Tokens:\n";
+        for (const Token &token : tokens) {
+            symbolTable.observe(token);
+            if (dumpTokens) {
+                token.format(dump);
+                dump << '\n';
+            }
+        }
+
+        ParallelParser parser(tokens, interner, &arena, parseMode, parseThreads());
+        SyntaxTree syntaxTree = parser.parse();
+        auto intermediateCode = lower(syntaxTree, parser.errors(), interner, arena);
+
+        PhaseStats unused;
+        return writeResults(symbolTable, syntaxTree, parser.errors(), intermediateCode, interner, dump, unused);
+    }
+
+    // The intermediate code, or none if there were syntax errors.
+    IntermediateCodeGenerator::Code lower(const SyntaxTree &syntaxTree, const vector<SyntaxError> &errors,
+                                          Interner &interner, Arena &arena) {
+        if (!errors.empty()) return IntermediateCodeGenerator::Code(&arena);
+        IntermediateCodeGenerator intermediateGenerator(interner, &arena, parseMode);
+        return intermediateGenerator.generate(syntaxTree);
+    }
+
+    // The whole token vector, loaded from the cache when there is one. The
+    // parallel lexer, if used, is left in `parallelLexer`: it owns the
+    // literal pools its tokens point into.
+    vector<Token> lexAll(string_view sourceCode, const TokenCacheFile *cache, Interner &interner, Arena &arena,
+                         unique_ptr<ParallelLexer> &parallelLexer) {
+        if (cache) return CachedTokens(*cache, sourceCode, interner).tokenize();
+        if (lexerThreads > 1) {
+            parallelLexer = make_unique<ParallelLexer>(sourceCode, interner, lexerThreads);
+            return parallelLexer->tokenize();
+        }
+        return Lexer(sourceCode, interner, &arena).tokenize();
+    }
+
+    void writeTokenCache(const vector<Token> &tokens, string_view sourceCode, const string &cachePath,
+                         Interner &interner) {
+        TokenReplay replay(tokens);
+        TokenCacheRecorder<TokenReplay> recorder(replay, sourceCode, interner);
+        while (recorder.nextToken().type != END_OF_FILE) {}
+        recorder.write(cachePath);
+    }
+
+    // compile() with statistics: each phase over the whole input in turn.
+    // Lexing means loading the tokens when the cache has them.
+    bool compileInPhases(string_view sourceCode, const TokenCacheFile *cache, const string &cachePath,
+                         Interner &interner, Arena &arena) {
+        PhaseStats phases;
+        vector<Token> tokens;
+        unique_ptr<ParallelLexer> parallelLexer;
+        {
+            PhaseStats::Scope lexing = phases.enter("lexing");
+            tokens = lexAll(sourceCode, cache, interner, arena, parallelLexer);
+            lexing.add(tokens.size(), 0, sourceCode.size());
+        }
+        if (!cache && !cachePath.empty()) {
+            PhaseStats::Scope caching = phases.enter("token cache");
+            writeTokenCache(tokens, sourceCode, cachePath, interner);
+            caching.add(tokens.size(), 0, 0);
+        }
+
+        DumpWriter dump(cout);
+        if (dumpTokens) {
+            PhaseStats::Scope output = phases.enter("output");
+            size_t before = dump.bytesWritten();
+            dump << "Tokens:\n";
+            for (const Token &token : tokens) {
+                token.format(dump);
+                dump << '\n';
+            }
+            output.add(tokens.size(), 0, dump.bytesWritten() - before);
+        }
+
+        SymbolTable symbolTable(interner, &arena);
+        {
+            PhaseStats::Scope symbols = phases.enter("symbols");
+            for (const Token &token : tokens) symbolTable.observe(token);
+            symbols.add(tokens.size(), 0, 0);
+        }
+
+        vector<SyntaxError> errors;
+        SyntaxTree syntaxTree = [&] {
+            PhaseStats::Scope parsing = phases.enter("parsing");
+            ParallelParser parser(tokens, interner, &arena, parseMode, parseThreads());
+            SyntaxTree tree = parser.parse();
+            errors = parser.errors();
+            parsing.add(tokens.size(), 0, 0);
+            return tree;
+        }();
+
+        auto intermediateCode = [&] {
+            PhaseStats::Scope intermediate = phases.enter("intermediate");
+            auto code = lower(syntaxTree, errors, interner, arena);
+            intermediate.add(0, code.size(), 0);
+            return code;
+        }();
+
+        bool translated = writeResults(symbolTable, syntaxTree, errors, intermediateCode, interner, dump, phases);
+
+        if (stats == STATS_JSON) {
+            phases.printJson(cerr);
+        } else {
+            phases.printTable(cerr);
+        }
+        return translated;
+    }
+
+    // Reports syntax errors on stderr, dumps the symbol table, syntax tree
+    // and intermediate code, then generates the assembly straight into the
+    // dump. Dump text is buffered: a full buffer is written out in whichever
+    // phase fills it. After a syntax error there is no code: only the symbol
+    // table and the tree are dumped, and the result is false.
+    bool writeResults(const SymbolTable &symbolTable, const SyntaxTree &syntaxTree, const vector<SyntaxError> &errors,
+                      const IntermediateCodeGenerator::Code &intermediateCode, const Interner &interner,
+                      DumpWriter &dump, PhaseStats &phases) {
+        for (const SyntaxError &error : errors) {
+            cerr << "Syntax error at line " << error.line << ", column " << error.column << ": " << error.message
+                 << endl;
         }
 
-        // Print Symbol Table
-        lexer.symbolTable.print();
+        {
+            PhaseStats::Scope output = phases.enter("output");
+            size_t before = dump.bytesWritten();
 
-                    // Intermediate Code Generation
-            IntermediateCodeGenerator intermediateGenerator;
-            auto intermediateCode = intermediateGenerator.generate(tokens);
+            // Print Symbol Table
+            if (dumpSymbols) symbolTable.print(dump);
+
+            // Print Syntax Tree
+            if (dumpSyntaxTree) {
+                dump << "\nSyntax Tree:\n";
+                syntaxTree.format(dump, interner);
+            }
 
             // Print Intermediate Code
-            cout << "\nIntermediate Code:\n";
-            for (const auto &code : intermediateCode)
-            {
-                cout << code.toString() << endl;
+            if (dumpIntermediate && errors.empty()) {
+                dump << "\nIntermediate Code:\n";
+                for (const auto &code : intermediateCode) {
+                    code.format(dump, interner);
+                    dump << '\n';
+                }
+                output.add(0, intermediateCode.size(), 0);
             }
+            output.add(0, 0, dump.bytesWritten() - before);
+        }
 
-            // Assembly Code Generation
-            AssemblyGenerator assemblyGenerator;
-            string assemblyCode = assemblyGenerator.generate(intermediateCode);
+        // Assembly Code Generation
+        if (dumpAssembly && errors.empty()) {
+            PhaseStats::Scope assembly = phases.enter("assembly");
+            size_t before = dump.bytesWritten();
+            AssemblyGenerator assemblyGenerator(interner);
+            dump << "\nAssembly Code:\n";
+            assemblyGenerator.generate(intermediateCode, dump);
+            dump << '\n';
+            assembly.add(0, intermediateCode.size(), dump.bytesWritten() - before);
+        }
 
-            // Print Assembly Code
-            cout << "\nAssembly Code:\n";
-            cout << assemblyCode << endl;
-        
-        
+        PhaseStats::Scope output = phases.enter("output");
+        dump.flush();
+        return errors.empty();
     }
 };
 
-int main() {
-    string sourceCode = R"(
+// Sample program compiled when no input file is given.
+static const char *const SAMPLE_PROGRAM = R"(
 
 int main() {
   
@@ -664,8 +4887,52 @@ void testFunction() {
 
     )";
 
+#ifndef KABIR_NO_MAIN
+// Usage: Complete-code [-j threads] [--parse-threads n] [--no-tokens] [--no-symbols] [--no-ir] [--no-asm]
+//                      [--ast] [--explicit-stack] [--token-cache dir] [--stats table|json] [file | -]
+// The exit status is 1 if the input had syntax errors or could not be read.
+int main(int argc, char *argv[]) {
     Kabir_ka_Compiler Kabir_ka_Compiler;
-    Kabir_ka_Compiler.compile(sourceCode);
+    int arg = 1;
+    for (; arg < argc; ++arg) {
+        string option = argv[arg];
+        if (option == "-j" && arg + 1 < argc) {
+            Kabir_ka_Compiler.lexerThreads = max(1, atoi(argv[++arg]));
+        } else if (option == "--parse-threads" && arg + 1 < argc) {
+            Kabir_ka_Compiler.parserThreads = max(1, atoi(argv[++arg]));
+        } else if (option == "--no-tokens") {
+            Kabir_ka_Compiler.dumpTokens = false;
+        } else if (option == "--no-symbols") {
+            Kabir_ka_Compiler.dumpSymbols = false;
+        } else if (option == "--no-ir") {
+            Kabir_ka_Compiler.dumpIntermediate = false;
+        } else if (option == "--no-asm") {
+            Kabir_ka_Compiler.dumpAssembly = false;
+        } else if (option == "--ast") {
+            Kabir_ka_Compiler.dumpSyntaxTree = true;
+        } else if (option == "--explicit-stack") {
+            Kabir_ka_Compiler.parseMode = EXPLICIT_STACK;
+        } else if (option == "--token-cache" && arg + 1 < argc) {
+            Kabir_ka_Compiler.tokenCacheDirectory = argv[++arg];
+        } else if (option == "--stats" && arg + 1 < argc) {
+            string format = argv[++arg];
+            Kabir_ka_Compiler.stats = format == "json" ? STATS_JSON : STATS_TABLE;
+        } else {
+            break;
+        }
+    }
+
+    if (arg < argc) {
+        try {
+            return Kabir_ka_Compiler.compileFile(argv[arg]) ? 0 : 1;
+        } catch (const runtime_error &e) {
+            cerr << "Error: " << e.what() << endl;
+            return 1;
+        }
+    }
+
+    string sourceCode = SAMPLE_PROGRAM;
 
-    return 0;
+    return Kabir_ka_Compiler.compile(sourceCode) ? 0 : 1;
 }
+#endif
@@ -0,0 +1,260 @@
+// Generated by "Lexer Generator/dfagen.cpp" from tokens.l. Do not edit.
+//
+// 171 states, 55 byte classes. Transitions are
+// premultiplied: an entry is the target state's row offset, so the
+// inner loop is state = dfaTransitions[state + dfaCharClass[byte]].
+// Row 0 is the dead state. Rows from DFA_FIRST_ACCEPTING on accept, and no
+// others do; dfaAccept is indexed by row offset / class count.
+
+#ifndef LEXER_TABLES_H
+#define LEXER_TABLES_H
+
+#include <cstdint>
+
+static const int DFA_CLASS_COUNT = 55;
+static const int DFA_STATE_COUNT = 171;
+static const int DFA_START = 55;
+static const int DFA_FIRST_ACCEPTING = 385;
+static const int DFA_NO_ACCEPT = -1;
+static const int DFA_SKIP = -2;
+
+static const uint8_t dfaCharClass[256] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 1, 1, 1, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 3, 4, 0, 0, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    16, 17, 17, 17, 17, 17, 17, 17, 17, 17, 18, 19, 20, 21, 22, 0,
+    0, 23, 23, 23, 23, 24, 25, 26, 26, 26, 26, 26, 27, 26, 26, 26,
+    26, 26, 26, 26, 26, 28, 26, 26, 29, 26, 26, 0, 30, 0, 0, 26,
+    0, 31, 32, 33, 34, 35, 36, 37, 38, 39, 26, 40, 41, 26, 42, 43,
+    44, 26, 45, 46, 47, 48, 49, 50, 29, 51, 26, 52, 53, 54, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+static const uint16_t dfaTransitions[9405] = {
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    385,440,440,495,550,605,660,715,770,825,880,935,990,1045,1100,1155,1210,1265,1320,1375,1430,1485,1540,1595,1595,1595,1595,1595,1595,1595,385,1595,1650,1705,1760,1815,1870,1595,1595,1925,1595,1595,1595,1595,1980,2035,2090,2145,1595,2200,2255,1595,2310,2365,2420,
+    0,0,0,0,0,0,0,4895,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    110,110,0,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,
+    0,0,0,0,0,0,0,0,0,0,0,330,0,330,0,0,5060,5060,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5335,5335,0,0,0,0,0,5335,5335,5335,0,0,0,0,0,5335,5335,5335,5335,5335,5335,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5060,5060,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,440,440,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2475,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    550,550,550,550,2530,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,2585,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2640,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,2695,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    110,110,0,110,110,110,110,0,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,165,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,110,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2750,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,2805,0,0,0,0,0,0,0,0,0,2860,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,2915,0,0,0,0,0,0,0,2970,3025,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,3080,0,0,0,0,3135,0,0,0,0,0,3190,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,3245,0,1265,1265,0,0,0,0,0,0,220,0,0,3300,3355,275,0,0,0,0,0,220,0,0,0,0,0,3410,0,0,0,0,0,0,3355,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,3245,0,1265,1265,0,0,0,0,0,0,220,0,0,3300,3355,0,0,0,0,0,0,220,0,0,0,0,0,3410,0,0,0,0,0,0,3355,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3465,3520,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3575,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3630,3685,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,3740,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,3795,1595,1595,1595,1595,1595,1595,3850,1595,1595,1595,1595,3905,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,3960,1595,1595,1595,1595,1595,1595,1595,4015,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,4070,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,4125,1595,4180,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,4235,1595,1595,1595,1595,1595,4290,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,4345,1595,1595,4400,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,4455,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,4510,1595,1595,4565,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,4620,1595,1595,1595,1595,1595,1595,4675,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,4730,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,4785,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,4840,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,550,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,4950,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,
+    3135,3135,0,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,3135,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3245,3245,0,0,0,0,0,0,220,5005,0,5005,0,0,0,0,0,0,0,220,5005,0,0,0,0,5005,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5115,5170,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5170,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5225,0,0,0,0,0,0,0,0,0,0,0,0,0,5280,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5170,0,0,0,0,0,0,0,0,0,0,0,0,5115,0,0,0,0,0,0,5170,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,5390,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,5445,5500,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,5555,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,5610,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,5665,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,5720,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,5775,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,5830,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,5885,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,5940,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,5995,1595,1595,1595,6050,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,6105,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,6160,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,6215,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,6270,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,6325,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,6380,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,6435,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,6490,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,4950,3080,3080,3080,3080,6545,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,3080,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5060,5060,0,0,0,0,0,0,0,5005,0,5005,0,0,0,0,0,0,0,0,5005,0,0,0,0,5005,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5170,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5170,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5170,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5170,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5335,5335,0,0,0,0,0,5335,5335,5335,0,3300,3355,0,0,5335,5335,5335,5335,5335,5335,0,0,0,0,3410,0,0,0,0,0,0,3355,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,6600,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,6655,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,6710,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,6765,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,6820,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,6875,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,6930,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,6985,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,7040,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,7095,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,7150,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,7205,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,7260,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,7315,1595,1595,1595,1595,1595,1595,1595,1595,7370,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,7425,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,7480,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,7535,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,7590,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,7645,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,7700,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,7755,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,7810,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,7865,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,7920,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,7975,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,8030,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,8085,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,8140,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,8195,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,8250,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,8305,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,8360,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,8415,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,8470,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,8525,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,8580,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,8635,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,8690,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,8745,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,8800,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,8855,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,8910,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,8965,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,9020,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,9075,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,9130,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,9185,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,9240,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,9295,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,9350,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1595,1595,0,0,0,0,0,1595,1595,1595,1595,1595,1595,1595,0,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,1595,0,0,0,
+};
+
+static const int dfaAccept[171] = {
+    DFA_NO_ACCEPT, DFA_NO_ACCEPT, DFA_NO_ACCEPT, DFA_NO_ACCEPT,
+    DFA_NO_ACCEPT, DFA_NO_ACCEPT, DFA_NO_ACCEPT, UNKNOWN,
+    DFA_SKIP, LOGICAL_NOT, UNKNOWN, MODULO,
+    REFERENCE, UNKNOWN, LEFT_PAREN, RIGHT_PAREN,
+    MULTIPLY, PLUS, COMMA, MINUS,
+    DOT, DIVIDE, INTEGER_LITERAL, INTEGER_LITERAL,
+    COLON, SEMICOLON, LESS_THAN, ASSIGN,
+    GREATER_THAN, IDENTIFIER, IDENTIFIER, IDENTIFIER,
+    IDENTIFIER, IDENTIFIER, IDENTIFIER, IDENTIFIER,
+    IDENTIFIER, IDENTIFIER, IDENTIFIER, IDENTIFIER,
+    IDENTIFIER, IDENTIFIER, LEFT_BRACE, UNKNOWN,
+    RIGHT_BRACE, NOT_EQUAL, STRING_LITERAL, UNKNOWN,
+    MODULO_ASSIGN, AND, MULTIPLY_ASSIGN, INCREMENT,
+    PLUS_ASSIGN, DECREMENT, MINUS_ASSIGN, MEMBER_ACCESS,
+    DFA_SKIP, DFA_SKIP, DIVIDE_ASSIGN, FLOAT_LITERAL,
+    INTEGER_LITERAL, INTEGER_LITERAL, INTEGER_LITERAL, SHIFT_LEFT,
+    LESS_EQUAL, EQUAL, GREATER_EQUAL, SHIFT_RIGHT,
+    IDENTIFIER, IDENTIFIER, IDENTIFIER, IDENTIFIER,
+    IDENTIFIER, IDENTIFIER, IDENTIFIER, IDENTIFIER,
+    IDENTIFIER, IF, IDENTIFIER, IDENTIFIER,
+    IDENTIFIER, IDENTIFIER, IDENTIFIER, IDENTIFIER,
+    IDENTIFIER, IDENTIFIER, IDENTIFIER, IDENTIFIER,
+    OR, CHAR_LITERAL, DFA_SKIP, FLOAT_LITERAL,
+    FLOAT_LITERAL, INTEGER_LITERAL, INTEGER_LITERAL, INTEGER_LITERAL,
+    INTEGER_LITERAL, INTEGER_LITERAL, IDENTIFIER, IDENTIFIER,
+    IDENTIFIER, IDENTIFIER, IDENTIFIER, IDENTIFIER,
+    IDENTIFIER, IDENTIFIER, IDENTIFIER, FOR,
+    INT, IDENTIFIER, IDENTIFIER, IDENTIFIER,
+    IDENTIFIER, IDENTIFIER, IDENTIFIER, IDENTIFIER,
+    TRY, IDENTIFIER, IDENTIFIER, DFA_SKIP,
+    IDENTIFIER, CASE, IDENTIFIER, CHAR,
+    IDENTIFIER, IDENTIFIER, IDENTIFIER, ELSE,
+    IDENTIFIER, IDENTIFIER, IDENTIFIER, IDENTIFIER,
+    IDENTIFIER, IDENTIFIER, IDENTIFIER, IDENTIFIER,
+    IDENTIFIER, VOID, IDENTIFIER, BREAK,
+    CATCH, IDENTIFIER, IDENTIFIER, IDENTIFIER,
+    FLOAT, IDENTIFIER, IDENTIFIER, IDENTIFIER,
+    IDENTIFIER, IDENTIFIER, IDENTIFIER, IDENTIFIER,
+    THROW, WHILE, IDENTIFIER, IDENTIFIER,
+    DOUBLE, IDENTIFIER, IDENTIFIER, PUBLIC,
+    RETURN, STRING, STRUCT, SWITCH,
+    IDENTIFIER, DEFAULT, PRIVATE, IDENTIFIER,
+    CONTINUE, IDENTIFIER, PROTECTED,
+};
+
+#endif
@@ -0,0 +1,553 @@
+// dfagen: compiles a lex-style token spec into minimised DFA tables.
+//
+//     g++ -std=c++17 -O2 dfagen.cpp -o dfagen
+//     ./dfagen "../Final Code & Report/tokens.l" "../Final Code & Report/lexer_tables.h"
+//
+// The spec follows week4/first.l: an optional definitions section, then "%%",
+// then one rule per line, then an optional "%%" and trailer (ignored).
+//
+//     DIGIT       [0-9]
+//     %%
+//     "if"            { return IF; }
+//     {DIGIT}+        { return INTEGER_LITERAL; }
+//     [ \t\n]+        { /* skip */ }
+//
+// Patterns support "quoted literals", [classes] with ranges and ^, ., (),
+// |, *, + and ?, {NAME} definitions and the escapes \n \t \v \f \r \xHH.
+// Unlike lex, a class or [\x00-\xff] may match any byte including newline;
+// "." excludes only '\n'. An action's "return NAME;" gives the token name
+// emitted into the table; an action without one marks a skipped lexeme.
+// As in lex, the longest match wins and ties go to the earlier rule.
+//
+// Pipeline: Thompson NFA -> byte equivalence classes -> subset construction
+// -> Moore partition refinement -> header with premultiplied transitions
+// by byte class, accepting states last.
+
+#include <algorithm>
+#include <bitset>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+typedef bitset<256> CharSet;
+
+struct Rule {
+    string pattern;
+    string token;  // Empty for skipped lexemes
+    int line;
+};
+
+// Thompson NFA: each state has epsilon edges and at most one byte-set edge.
+class Nfa {
+public:
+    struct State {
+        vector<int> epsilon;
+        int charSet = -1;
+        int target = -1;
+        int rule = -1;
+    };
+
+    vector<State> states;
+    vector<CharSet> charSets;
+
+    int addState() {
+        states.push_back(State());
+        return (int)states.size() - 1;
+    }
+
+    void addEdge(int from, const CharSet &set, int to) {
+        charSets.push_back(set);
+        states[from].charSet = (int)charSets.size() - 1;
+        states[from].target = to;
+    }
+};
+
+// Recursive-descent parser from a pattern to an NFA fragment.
+class PatternParser {
+public:
+    PatternParser(Nfa &nfa, const map<string, string> &definitions)
+        : nfa(nfa), definitions(definitions) {}
+
+    // Returns {start, end} of the fragment for `pattern`.
+    pair<int, int> parse(const string &pattern, int depth = 0) {
+        if (depth > 32) throw runtime_error("definitions nest too deeply");
+        string savedText = text;
+        size_t savedPos = pos;
+        int savedDepth = nesting;
+        text = pattern;
+        pos = 0;
+        nesting = depth;
+        pair<int, int> fragment = parseAlternation();
+        if (pos != text.size()) throw runtime_error("unexpected '" + string(1, text[pos]) + "' in pattern");
+        text = savedText;
+        pos = savedPos;
+        nesting = savedDepth;
+        return fragment;
+    }
+
+private:
+    Nfa &nfa;
+    const map<string, string> &definitions;
+    string text;
+    size_t pos = 0;
+    int nesting = 0;
+
+    bool atEnd() const {
+        return pos >= text.size();
+    }
+
+    pair<int, int> parseAlternation() {
+        pair<int, int> left = parseConcatenation();
+        while (!atEnd() && text[pos] == '|') {
+            pos++;
+            pair<int, int> right = parseConcatenation();
+            int start = nfa.addState(), end = nfa.addState();
+            nfa.states[start].epsilon = {left.first, right.first};
+            nfa.states[left.second].epsilon.push_back(end);
+            nfa.states[right.second].epsilon.push_back(end);
+            left = {start, end};
+        }
+        return left;
+    }
+
+    pair<int, int> parseConcatenation() {
+        int start = nfa.addState();
+        int end = start;
+        while (!atEnd() && text[pos] != '|' && text[pos] != ')') {
+            pair<int, int> next = parseRepetition();
+            nfa.states[end].epsilon.push_back(next.first);
+            end = next.second;
+        }
+        return {start, end};
+    }
+
+    pair<int, int> parseRepetition() {
+        pair<int, int> atom = parseAtom();
+        while (!atEnd() && (text[pos] == '*' || text[pos] == '+' || text[pos] == '?')) {
+            char op = text[pos++];
+            int start = nfa.addState(), end = nfa.addState();
+            nfa.states[start].epsilon.push_back(atom.first);
+            nfa.states[atom.second].epsilon.push_back(end);
+            if (op != '+') nfa.states[start].epsilon.push_back(end);
+            if (op != '?') nfa.states[atom.second].epsilon.push_back(atom.first);
+            atom = {start, end};
+        }
+        return atom;
+    }
+
+    pair<int, int> single(const CharSet &set) {
+        int start = nfa.addState(), end = nfa.addState();
+        nfa.addEdge(start, set, end);
+        return {start, end};
+    }
+
+    pair<int, int> parseAtom() {
+        char c = text[pos++];
+        switch (c) {
+            case '(': {
+                pair<int, int> inner = parseAlternation();
+                if (atEnd() || text[pos] != ')') throw runtime_error("missing ')'");
+                pos++;
+                return inner;
+            }
+            case '"': {
+                int start = nfa.addState();
+                int end = start;
+                while (!atEnd() && text[pos] != '"') {
+                    CharSet set;
+                    set.set(text[pos] == '\\' ? parseEscape() : (unsigned char)text[pos++]);
+                    int next = nfa.addState();
+                    nfa.addEdge(end, set, next);
+                    end = next;
+                }
+                if (atEnd()) throw runtime_error("unterminated quoted literal");
+                pos++;
+                return {start, end};
+            }
+            case '[':
+                return single(parseClass());
+            case '.': {
+                CharSet set;
+                set.set();
+                set.reset('\n');
+                return single(set);
+            }
+            case '\\': {
+                pos--;
+                CharSet set;
+                set.set(parseEscape());
+                return single(set);
+            }
+            case '{': {
+                size_t close = text.find('}', pos);
+                if (close == string::npos) throw runtime_error("missing '}'");
+                string name = text.substr(pos, close - pos);
+                auto it = definitions.find(name);
+                if (it == definitions.end()) throw runtime_error("undefined definition {" + name + "}");
+                pos = close + 1;
+                return parse("(" + it->second + ")", nesting + 1);
+            }
+            case '*': case '+': case '?': case '|': case ')':
+                throw runtime_error("unexpected '" + string(1, c) + "' in pattern");
+            default: {
+                CharSet set;
+                set.set((unsigned char)c);
+                return single(set);
+            }
+        }
+    }
+
+    int hexValue(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        throw runtime_error("bad hex escape");
+    }
+
+    // Parses an escape starting at the backslash and returns its byte.
+    unsigned char parseEscape() {
+        pos++;
+        if (atEnd()) throw runtime_error("dangling backslash");
+        char c = text[pos++];
+        switch (c) {
+            case 'n': return '\n';
+            case 't': return '\t';
+            case 'v': return '\v';
+            case 'f': return '\f';
+            case 'r': return '\r';
+            case 'x': {
+                if (pos + 2 > text.size()) throw runtime_error("bad hex escape");
+                int value = hexValue(text[pos]) * 16 + hexValue(text[pos + 1]);
+                pos += 2;
+                return (unsigned char)value;
+            }
+            default: return (unsigned char)c;
+        }
+    }
+
+    CharSet parseClass() {
+        CharSet set;
+        bool negate = !atEnd() && text[pos] == '^';
+        if (negate) pos++;
+        bool first = true;
+        while (!atEnd() && (text[pos] != ']' || first)) {
+            first = false;
+            unsigned char low = text[pos] == '\\' ? parseEscape() : (unsigned char)text[pos++];
+            unsigned char high = low;
+            if (pos + 1 < text.size() && text[pos] == '-' && text[pos + 1] != ']') {
+                pos++;
+                high = text[pos] == '\\' ? parseEscape() : (unsigned char)text[pos++];
+            }
+            for (int b = low; b <= high; ++b) set.set(b);
+        }
+        if (atEnd()) throw runtime_error("missing ']'");
+        pos++;
+        return negate ? ~set : set;
+    }
+};
+
+struct Spec {
+    map<string, string> definitions;
+    vector<Rule> rules;
+};
+
+static string trim(const string &s) {
+    size_t b = s.find_first_not_of(" \t\r");
+    if (b == string::npos) return "";
+    size_t e = s.find_last_not_of(" \t\r");
+    return s.substr(b, e - b + 1);
+}
+
+// Splits a rule line into the pattern (up to the first whitespace outside
+// quotes and brackets) and the action.
+static pair<string, string> splitRule(const string &line) {
+    bool quoted = false;
+    int brackets = 0;
+    for (size_t i = 0; i < line.size(); ++i) {
+        char c = line[i];
+        if (c == '\\') {
+            i++;
+            continue;
+        }
+        if (c == '"' && brackets == 0) quoted = !quoted;
+        else if (!quoted && c == '[') brackets++;
+        else if (!quoted && c == ']' && brackets > 0) brackets--;
+        else if (!quoted && brackets == 0 && (c == ' ' || c == '\t')) {
+            return {line.substr(0, i), trim(line.substr(i))};
+        }
+    }
+    return {line, ""};
+}
+
+static string tokenOf(const string &action) {
+    size_t at = action.find("return");
+    if (at == string::npos) return "";
+    at += 6;
+    while (at < action.size() && isspace((unsigned char)action[at])) at++;
+    size_t end = at;
+    while (end < action.size() && (isalnum((unsigned char)action[end]) || action[end] == '_')) end++;
+    if (end == at) throw runtime_error("'return' without a token name");
+    return action.substr(at, end - at);
+}
+
+static Spec readSpec(istream &in) {
+    Spec spec;
+    string line;
+    int lineNumber = 0;
+    int section = 0;
+    bool inCode = false;
+    while (getline(in, line)) {
+        lineNumber++;
+        string t = trim(line);
+        if (t == "%{") { inCode = true; continue; }
+        if (t == "%}") { inCode = false; continue; }
+        if (inCode) continue;
+        if (t == "%%") {
+            section++;
+            continue;
+        }
+        if (t.empty() || t.compare(0, 2, "/*") == 0 || t.compare(0, 2, "//") == 0) continue;
+        if (section == 0) {
+            pair<string, string> parts = splitRule(t);
+            spec.definitions[parts.first] = parts.second;
+        } else if (section == 1) {
+            pair<string, string> parts = splitRule(t);
+            try {
+                spec.rules.push_back({parts.first, tokenOf(parts.second), lineNumber});
+            } catch (const runtime_error &e) {
+                throw runtime_error("line " + to_string(lineNumber) + ": " + e.what());
+            }
+        }
+    }
+    if (spec.rules.empty()) throw runtime_error("spec has no rules");
+    return spec;
+}
+
+struct Dfa {
+    int classCount = 0;
+    vector<int> classOf;             // byte -> class
+    vector<vector<int>> transitions;  // state -> class -> state; state 0 is dead
+    vector<int> accept;              // state -> rule index, -1 if none
+    int start = 1;
+};
+
+static vector<int> closure(const Nfa &nfa, vector<int> set) {
+    vector<bool> seen(nfa.states.size());
+    vector<int> stack = set;
+    for (int s : set) seen[s] = true;
+    while (!stack.empty()) {
+        int s = stack.back();
+        stack.pop_back();
+        for (int t : nfa.states[s].epsilon) {
+            if (!seen[t]) {
+                seen[t] = true;
+                set.push_back(t);
+                stack.push_back(t);
+            }
+        }
+    }
+    sort(set.begin(), set.end());
+    return set;
+}
+
+static Dfa buildDfa(const Nfa &nfa, int nfaStart) {
+    Dfa dfa;
+
+    // Bytes that no byte-set tells apart share a class.
+    map<vector<bool>, int> signatures;
+    dfa.classOf.resize(256);
+    vector<int> representative;
+    for (int b = 0; b < 256; ++b) {
+        vector<bool> signature;
+        for (const CharSet &set : nfa.charSets) signature.push_back(set.test(b));
+        auto inserted = signatures.insert({signature, (int)signatures.size()});
+        if (inserted.second) representative.push_back(b);
+        dfa.classOf[b] = inserted.first->second;
+    }
+    dfa.classCount = (int)signatures.size();
+
+    map<vector<int>, int> ids;
+    vector<vector<int>> sets;
+    ids[vector<int>()] = 0;
+    sets.push_back(vector<int>());
+    vector<int> startSet = closure(nfa, {nfaStart});
+    ids[startSet] = 1;
+    sets.push_back(startSet);
+
+    for (size_t d = 0; d < sets.size(); ++d) {
+        vector<int> row(dfa.classCount, 0);
+        for (int cls = 0; cls < dfa.classCount && d != 0; ++cls) {
+            int byte = representative[cls];
+            vector<int> moved;
+            for (int s : sets[d]) {
+                const Nfa::State &state = nfa.states[s];
+                if (state.charSet >= 0 && nfa.charSets[state.charSet].test(byte)) moved.push_back(state.target);
+            }
+            if (moved.empty()) continue;
+            moved = closure(nfa, moved);
+            auto inserted = ids.insert({moved, (int)sets.size()});
+            if (inserted.second) sets.push_back(moved);
+            row[cls] = inserted.first->second;
+        }
+        dfa.transitions.push_back(row);
+
+        int rule = -1;
+        for (int s : sets[d]) {
+            int r = nfa.states[s].rule;
+            if (r >= 0 && (rule < 0 || r < rule)) rule = r;
+        }
+        dfa.accept.push_back(rule);
+    }
+    return dfa;
+}
+
+// Moore refinement. States start out grouped by what they accept (the token
+// name, not the rule, so keyword-like rules for the same token can merge),
+// then split until every block agrees on where each class leads.
+static Dfa minimize(const Dfa &dfa, const vector<Rule> &rules) {
+    size_t n = dfa.transitions.size();
+    vector<int> block(n);
+    map<string, int> initial;
+    for (size_t s = 0; s < n; ++s) {
+        string key = dfa.accept[s] < 0 ? "" : "=" + rules[dfa.accept[s]].token;
+        if (s == 0) key = "dead";
+        block[s] = initial.insert({key, (int)initial.size()}).first->second;
+    }
+
+    size_t blockCount = initial.size();
+    while (true) {
+        map<vector<int>, int> keys;
+        vector<int> next(n);
+        for (size_t s = 0; s < n; ++s) {
+            vector<int> key = {block[s]};
+            for (int t : dfa.transitions[s]) key.push_back(block[t]);
+            next[s] = keys.insert({key, (int)keys.size()}).first->second;
+        }
+        block = next;
+        if (keys.size() == blockCount) break;
+        blockCount = keys.size();
+    }
+
+    // Renumber so the dead state stays 0, the start state is 1 and the
+    // accepting states come last: a lexer then tells whether a state accepts
+    // by comparing its number. Blocks agree on accepting, so any member says.
+    vector<int> renumber(blockCount, -1);
+    int count = 0;
+    renumber[block[0]] = count++;
+    if (renumber[block[dfa.start]] < 0) renumber[block[dfa.start]] = count++;
+    for (bool accepting : {false, true}) {
+        for (size_t s = 0; s < n; ++s) {
+            if (renumber[block[s]] < 0 && (dfa.accept[s] >= 0) == accepting) renumber[block[s]] = count++;
+        }
+    }
+
+    Dfa result;
+    result.classCount = dfa.classCount;
+    result.classOf = dfa.classOf;
+    result.transitions.assign(count, vector<int>(dfa.classCount, 0));
+    result.accept.assign(count, -1);
+    result.start = renumber[block[dfa.start]];
+    for (size_t s = 0; s < n; ++s) {
+        int m = renumber[block[s]];
+        for (int c = 0; c < dfa.classCount; ++c) result.transitions[m][c] = renumber[block[dfa.transitions[s][c]]];
+        if (dfa.accept[s] >= 0 && (result.accept[m] < 0 || dfa.accept[s] < result.accept[m])) {
+            result.accept[m] = dfa.accept[s];
+        }
+    }
+    return result;
+}
+
+static void writeHeader(ostream &out, const Dfa &dfa, const vector<Rule> &rules, const string &specName) {
+    size_t states = dfa.transitions.size();
+    size_t cells = states * dfa.classCount;
+    if (cells > 0xFFFF) throw runtime_error("more than 65535 transitions do not fit 16-bit entries");
+    if (dfa.accept[dfa.start] >= 0) throw runtime_error("a rule matches the empty string");
+    size_t firstAccepting = states;
+    while (firstAccepting > 0 && dfa.accept[firstAccepting - 1] >= 0) --firstAccepting;
+
+    out << "// Generated by \"Lexer Generator/dfagen.cpp\" from " << specName << ". Do not edit.\n";
+    out << "//\n";
+    out << "// " << states << " states, " << dfa.classCount << " byte classes. Transitions are\n";
+    out << "// premultiplied: an entry is the target state's row offset, so the\n";
+    out << "// inner loop is state = dfaTransitions[state + dfaCharClass[byte]].\n";
+    out << "// Row 0 is the dead state. Rows from DFA_FIRST_ACCEPTING on accept, and no\n";
+    out << "// others do; dfaAccept is indexed by row offset / class count.\n\n";
+    out << "#ifndef LEXER_TABLES_H\n#define LEXER_TABLES_H\n\n#include <cstdint>\n\n";
+    out << "static const int DFA_CLASS_COUNT = " << dfa.classCount << ";\n";
+    out << "static const int DFA_STATE_COUNT = " << states << ";\n";
+    out << "static const int DFA_START = " << dfa.start * dfa.classCount << ";\n";
+    out << "static const int DFA_FIRST_ACCEPTING = " << firstAccepting * dfa.classCount << ";\n";
+    out << "static const int DFA_NO_ACCEPT = -1;\n";
+    out << "static const int DFA_SKIP = -2;\n\n";
+
+    out << "static const uint8_t dfaCharClass[256] = {";
+    for (int b = 0; b < 256; ++b) out << (b % 16 == 0 ? "\n    " : " ") << dfa.classOf[b] << ",";
+    out << "\n};\n\n";
+
+    out << "static const uint16_t dfaTransitions[" << cells << "] = {";
+    for (size_t s = 0; s < states; ++s) {
+        out << "\n    ";
+        for (int c = 0; c < dfa.classCount; ++c) out << dfa.transitions[s][c] * dfa.classCount << ",";
+    }
+    out << "\n};\n\n";
+
+    out << "static const int dfaAccept[" << states << "] = {";
+    for (size_t s = 0; s < states; ++s) {
+        out << (s % 4 == 0 ? "\n    " : " ");
+        int rule = dfa.accept[s];
+        if (rule < 0) out << "DFA_NO_ACCEPT,";
+        else if (rules[rule].token.empty()) out << "DFA_SKIP,";
+        else out << rules[rule].token << ",";
+    }
+    out << "\n};\n\n#endif\n";
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        cerr << "Usage: " << argv[0] << " <spec.l> <output.h>" << endl;
+        return 1;
+    }
+
+    try {
+        ifstream in(argv[1]);
+        if (!in) throw runtime_error(string("could not open ") + argv[1]);
+        Spec spec = readSpec(in);
+
+        Nfa nfa;
+        PatternParser parser(nfa, spec.definitions);
+        int start = nfa.addState();
+        for (size_t r = 0; r < spec.rules.size(); ++r) {
+            pair<int, int> fragment;
+            try {
+                fragment = parser.parse(spec.rules[r].pattern);
+            } catch (const runtime_error &e) {
+                throw runtime_error("line " + to_string(spec.rules[r].line) + ": " + e.what());
+            }
+            nfa.states[start].epsilon.push_back(fragment.first);
+            nfa.states[fragment.second].rule = (int)r;
+        }
+
+        Dfa dfa = minimize(buildDfa(nfa, start), spec.rules);
+
+        string specName = argv[1];
+        size_t slash = specName.find_last_of("/\\");
+        if (slash != string::npos) specName = specName.substr(slash + 1);
+
+        ofstream out(argv[2]);
+        if (!out) throw runtime_error(string("could not write ") + argv[2]);
+        writeHeader(out, dfa, spec.rules, specName);
+        cout << spec.rules.size() << " rules, " << nfa.states.size() << " NFA states -> "
+             << dfa.transitions.size() << " DFA states, " << dfa.classCount << " byte classes" << endl;
+    } catch (const runtime_error &e) {
+        cerr << "dfagen: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
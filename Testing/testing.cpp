@@ -6,6 +6,7 @@
 #include <sstream>
 #include <stack> 
 #include <stdexcept>
+#include "../common/keyword_table.h"
 // #define AND &&
 
 using namespace std;
@@ -288,7 +289,7 @@ private:
             identifier += advance();
         }
 
-        static const unordered_map<string, TokenType> keywords = {
+        static constexpr auto keywords = makeKeywordTable<TokenType>({
             {"if", IF}, {"else", ELSE},   {"while", WHILE}, {"for", FOR}, {"return", RETURN},
             {"int", INT}, {"float", FLOAT}, {"double", DOUBLE},
             {"char", CHAR}, {"string", STRING}, {"void", VOID},
@@ -296,11 +297,11 @@ private:
             {"case", CASE}, {"default", DEFAULT}, {"public", PUBLIC},
             {"private", PRIVATE}, {"protected", PROTECTED}, {"try", TRY},
             {"catch", CATCH}, {"throw", THROW} ,{"struct", STRUCT } 
-        };
+        });
 
-        auto it = keywords.find(identifier);
-        if (it != keywords.end()) {
-            return {it->second, identifier, line, column};
+        TokenType keyword = keywords.find(identifier, IDENTIFIER);
+        if (keyword != IDENTIFIER) {
+            return {keyword, identifier, line, column};
         } else {
             string value = "";
             if (!tokens.empty() && tokens.back().type == ASSIGN) {
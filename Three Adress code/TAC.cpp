@@ -1,19 +1,50 @@
 #include <iostream>
 #include <vector>
 #include <string>
-#include <map>
 #include <stdexcept>
+#include <array>
+#include "../common/keyword_table.h"
+#include "../common/token_stream.h"
+#include "../common/interner.h"
+#include "../common/scoped_symbol_table.h"
 
 using namespace std;
 
 enum TokenType {
     T_INT, T_ID, T_NUM, T_IF, T_ELSE, T_RETURN, 
     T_FOR, T_WHILE, // Added tokens for for and while
-    T_ASSIGN, T_PLUS, T_MINUS, T_MUL, T_DIV, 
+    T_ASSIGN, T_PLUS, T_MINUS, T_MUL, T_DIV, T_MOD,
     T_LPAREN, T_RPAREN, T_LBRACE, T_RBRACE,  
-    T_SEMICOLON, T_GT, T_EOF
+    T_SEMICOLON, T_GT, T_LT, T_GE, T_LE, T_EQ, T_NE,
+    T_AND, T_OR, T_NOT, T_AMP, T_EOF
 };
 
+struct BinaryOperator {
+    int precedence;  // 0 if the token is not a binary operator
+    const char *symbol;
+};
+
+// Binding power of each binary operator, indexed by token type. `*` and `-`
+// are also unary; parseUnary sees them first, so the table only describes
+// their infix use.
+static constexpr array<BinaryOperator, T_EOF + 1> BINARY_OPERATORS = [] {
+    array<BinaryOperator, T_EOF + 1> table{};
+    table[T_OR] = {1, "||"};
+    table[T_AND] = {2, "&&"};
+    table[T_EQ] = {3, "=="};
+    table[T_NE] = {3, "!="};
+    table[T_LT] = {4, "<"};
+    table[T_LE] = {4, "<="};
+    table[T_GT] = {4, ">"};
+    table[T_GE] = {4, ">="};
+    table[T_PLUS] = {5, "+"};
+    table[T_MINUS] = {5, "-"};
+    table[T_MUL] = {6, "*"};
+    table[T_DIV] = {6, "/"};
+    table[T_MOD] = {6, "%"};
+    return table;
+}();
+
 struct Token {
     TokenType type;
     string value;
@@ -31,6 +62,14 @@ public:
 
     vector<Token> tokenize() {
         vector<Token> tokens;
+        do {
+            tokens.push_back(nextToken());
+        } while (tokens.back().type != T_EOF);
+        return tokens;
+    }
+
+    // Scans one token; T_EOF at the end of input (and on every call after).
+    Token nextToken() {
         while (pos < src.size()) {
             char current = src[pos];
 
@@ -44,44 +83,59 @@ public:
                 continue;
             }
             if (isdigit(current)) {
-                tokens.push_back(Token{T_NUM, consumeNumber(), lineNumber});
-                continue;
+                return Token{T_NUM, consumeNumber(), lineNumber};
             }
             if (isalpha(current)) {
+                static constexpr auto keywords = makeKeywordTable<TokenType>({
+                    {"int", T_INT}, {"if", T_IF}, {"else", T_ELSE}, {"return", T_RETURN},
+                    {"for", T_FOR}, {"while", T_WHILE}
+                });
                 string word = consumeWord();
-                TokenType type = T_ID;
-
-                if (word == "int") type = T_INT;
-                else if (word == "if") type = T_IF;
-                else if (word == "else") type = T_ELSE;
-                else if (word == "return") type = T_RETURN;
-                else if (word == "for") type = T_FOR;     // Added recognition for for
-                else if (word == "while") type = T_WHILE; // Added recognition for while
-
-                tokens.push_back(Token{type, word, lineNumber});
-                continue;
+                return Token{keywords.find(word, T_ID), word, lineNumber};
             }
 
+            Token token;
             switch (current) {
-                case '=': tokens.push_back(Token{T_ASSIGN, "=", lineNumber}); break;
-                case '+': tokens.push_back(Token{T_PLUS, "+", lineNumber}); break;
-                case '-': tokens.push_back(Token{T_MINUS, "-", lineNumber}); break;
-                case '*': tokens.push_back(Token{T_MUL, "*", lineNumber}); break;
-                case '/': tokens.push_back(Token{T_DIV, "/", lineNumber}); break;
-                case '(': tokens.push_back(Token{T_LPAREN, "(", lineNumber}); break;
-                case ')': tokens.push_back(Token{T_RPAREN, ")", lineNumber}); break;
-                case '{': tokens.push_back(Token{T_LBRACE, "{", lineNumber}); break;
-                case '}': tokens.push_back(Token{T_RBRACE, "}", lineNumber}); break;
-                case ';': tokens.push_back(Token{T_SEMICOLON, ";", lineNumber}); break;
-                case '>': tokens.push_back(Token{T_GT, ">", lineNumber}); break;
+                case '=': token = followedBy('=') ? Token{T_EQ, "==", lineNumber} : Token{T_ASSIGN, "=", lineNumber}; break;
+                case '!': token = followedBy('=') ? Token{T_NE, "!=", lineNumber} : Token{T_NOT, "!", lineNumber}; break;
+                case '<': token = followedBy('=') ? Token{T_LE, "<=", lineNumber} : Token{T_LT, "<", lineNumber}; break;
+                case '>': token = followedBy('=') ? Token{T_GE, ">=", lineNumber} : Token{T_GT, ">", lineNumber}; break;
+                case '&': token = followedBy('&') ? Token{T_AND, "&&", lineNumber} : Token{T_AMP, "&", lineNumber}; break;
+                case '|':
+                    if (!followedBy('|')) {
+                        cout << "Unexpected character: " << current << " at line " << lineNumber << endl;
+                        exit(1);
+                    }
+                    token = Token{T_OR, "||", lineNumber};
+                    break;
+                case '+': token = Token{T_PLUS, "+", lineNumber}; break;
+                case '-': token = Token{T_MINUS, "-", lineNumber}; break;
+                case '*': token = Token{T_MUL, "*", lineNumber}; break;
+                case '/': token = Token{T_DIV, "/", lineNumber}; break;
+                case '%': token = Token{T_MOD, "%", lineNumber}; break;
+                case '(': token = Token{T_LPAREN, "(", lineNumber}; break;
+                case ')': token = Token{T_RPAREN, ")", lineNumber}; break;
+                case '{': token = Token{T_LBRACE, "{", lineNumber}; break;
+                case '}': token = Token{T_RBRACE, "}", lineNumber}; break;
+                case ';': token = Token{T_SEMICOLON, ";", lineNumber}; break;
                 default:
                     cout << "Unexpected character: " << current << " at line " << lineNumber << endl;
                     exit(1);
             }
             pos++;
+            return token;
         }
-        tokens.push_back(Token{T_EOF, "", lineNumber});
-        return tokens;
+        return Token{T_EOF, "", lineNumber};
+    }
+
+    // For two-character operators: steps onto the second character if it is
+    // `next`, leaving the pos++ after the switch to consume it.
+    bool followedBy(char next) {
+        if (pos + 1 < src.size() && src[pos + 1] == next) {
+            pos++;
+            return true;
+        }
+        return false;
     }
 
     string consumeNumber() {
@@ -97,28 +151,40 @@ public:
     }
 };
 
+// Block-scoped: a name may be redeclared in an inner block, shadowing the
+// outer one until the block ends.
 class SymbolTable {
 public:
+    void enterScope() {
+        symbolTable.enterScope();
+    }
+
+    void exitScope() {
+        symbolTable.exitScope();
+    }
+
     void declareVariable(const string &name, const string &type) {
-        if (symbolTable.find(name) != symbolTable.end()) {
+        if (!symbolTable.declare(names.intern(name), type)) {
             throw runtime_error("Semantic error: Variable '" + name + "' is already declared.");
         }
-        symbolTable[name] = type;
     }
 
     string getVariableType(const string &name) {
-        if (symbolTable.find(name) == symbolTable.end()) {
+        const string *type = symbolTable.lookup(names.intern(name));
+        if (!type) {
             throw runtime_error("Semantic error: Variable '" + name + "' is not declared.");
         }
-        return symbolTable[name];
+        return *type;
     }
 
     bool isDeclared(const string &name) const {
-        return symbolTable.find(name) != symbolTable.end();
+        uint32_t id = names.find(name);
+        return id != Interner::NOT_FOUND && symbolTable.lookup(id);
     }
 
 private:
-    map<string, string> symbolTable;
+    Interner names;
+    ScopedSymbolTable<string> symbolTable;
 };
 
 class IntermediateCodeGnerator {
@@ -143,39 +209,83 @@ public:
 
 class Parser {
 public:
-    Parser(const vector<Token> &tokens, SymbolTable &symTable, IntermediateCodeGnerator &icg)
-        : tokens(tokens), pos(0), symTable(symTable), icg(icg) {}
-
+    // Tokens are pulled from the lexer as the parser needs them; only the
+    // stream's small lookahead buffer is ever held in memory.
+    Parser(TokenStream<Lexer> &tokens, SymbolTable &symTable, IntermediateCodeGnerator &icg)
+        : tokens(tokens), symTable(symTable), icg(icg) {}
+
+    // Reports every error in the program, not just the first: a statement
+    // that fails is skipped (see synchronize) and parsing carries on, so the
+    // code generated for the statements around it is still emitted.
     void parseProgram() {
-        while (tokens[pos].type != T_EOF) {
+        while (tokens.peek().type != T_EOF) {
             parseStatement();
         }
     }
 
+    int errorCount() const {
+        return errors;
+    }
+
 private:
-    vector<Token> tokens;
-    size_t pos;
+    TokenStream<Lexer> &tokens;
     SymbolTable &symTable;
     IntermediateCodeGnerator &icg;
+    int errors = 0;
+    int depth = 0;  // Blocks open around the current statement
 
+    // Syntax and semantic errors are thrown as runtime_error out of whatever
+    // the statement was in the middle of, and caught here.
     void parseStatement() {
-        if (tokens[pos].type == T_INT) {
+        try {
+            parseStatementOrThrow();
+        } catch (const runtime_error &e) {
+            cout << e.what() << endl;
+            errors++;
+            synchronize();
+        }
+    }
+
+    // Panic mode: skips the rest of the broken statement, up to and including
+    // its ';', or up to the '}' closing the enclosing block or a token that
+    // can only start a statement. A '}' with no block open is skipped too, so
+    // every error moves the parser forward.
+    void synchronize() {
+        for (;;) {
+            switch (tokens.peek().type) {
+                case T_EOF: case T_INT: case T_IF: case T_WHILE: case T_FOR: case T_RETURN: case T_LBRACE:
+                    return;
+                case T_SEMICOLON:
+                    tokens.nextToken();
+                    return;
+                case T_RBRACE:
+                    if (depth > 0) return;
+                    tokens.nextToken();
+                    break;
+                default:
+                    tokens.nextToken();
+            }
+        }
+    }
+
+    void parseStatementOrThrow() {
+        if (tokens.peek().type == T_INT) {
             parseDeclaration();
-        } else if (tokens[pos].type == T_ID) {
+        } else if (tokens.peek().type == T_ID) {
             parseAssignment();
-        } else if (tokens[pos].type == T_IF) {
+        } else if (tokens.peek().type == T_IF) {
             parseIfStatement();
-        } else if (tokens[pos].type == T_WHILE) {
+        } else if (tokens.peek().type == T_WHILE) {
             parseWhileLoop();
-        } else if (tokens[pos].type == T_FOR) {
+        } else if (tokens.peek().type == T_FOR) {
             parseForLoop();
-        } else if (tokens[pos].type == T_RETURN) {
+        } else if (tokens.peek().type == T_RETURN) {
             parseReturnStatement();
-        } else if (tokens[pos].type == T_LBRACE) {
+        } else if (tokens.peek().type == T_LBRACE) {
             parseBlock();
         } else {
-            cout << "Syntax error: unexpected token '" << tokens[pos].value << "' at line " << tokens[pos].lineNumber << endl;
-            exit(1);
+            throw runtime_error("Syntax error: unexpected token '" + tokens.peek().value + "' at line " +
+                                to_string(tokens.peek().lineNumber));
         }
     }
 
@@ -197,7 +307,7 @@ private:
 
         parseStatement();
 
-        if (tokens[pos].type == T_ELSE) {
+        if (tokens.peek().type == T_ELSE) {
             string labelElse = icg.newTemp();
             icg.addInstruction("goto " + labelElse);
             icg.addInstruction(labelEnd + ":");
@@ -252,11 +362,15 @@ private:
         icg.addInstruction("goto " + endLabel);
 
         icg.addInstruction(bodyLabel + ":");
-        string update = parseExpression(); // Update
+        // The update runs after the body, so its code is set aside until then.
+        size_t updateStart = icg.instructions.size();
+        parseAssignmentExpression(); // Update
+        vector<string> update(icg.instructions.begin() + updateStart, icg.instructions.end());
+        icg.instructions.resize(updateStart);
         expect(T_RPAREN);
 
         parseStatement(); // Body
-        icg.addInstruction(update); // Apply update
+        icg.instructions.insert(icg.instructions.end(), update.begin(), update.end());
         icg.addInstruction("goto " + condLabel);
         icg.addInstruction(endLabel + ":");
     }
@@ -265,16 +379,26 @@ private:
         expect(T_INT);
         string varName = expectAndReturnValue(T_ID);
         symTable.declareVariable(varName, "int");
+        if (tokens.peek().type == T_ASSIGN) {
+            tokens.nextToken();
+            string expr = parseExpression();
+            icg.addInstruction(varName + " = " + expr);
+        }
         expect(T_SEMICOLON);
     }
 
     void parseAssignment() {
+        parseAssignmentExpression();
+        expect(T_SEMICOLON);
+    }
+
+    // `name = expression` without the semicolon, as in a for loop's update.
+    void parseAssignmentExpression() {
         string varName = expectAndReturnValue(T_ID);
         symTable.getVariableType(varName);
         expect(T_ASSIGN);
         string expr = parseExpression();
         icg.addInstruction(varName + " = " + expr);
-        expect(T_SEMICOLON);
     }
 
     void parseReturnStatement() {
@@ -286,69 +410,74 @@ private:
 
     void parseBlock() {
         expect(T_LBRACE);
-        while (tokens[pos].type != T_RBRACE && tokens[pos].type != T_EOF) {
+        symTable.enterScope();
+        depth++;
+        while (tokens.peek().type != T_RBRACE && tokens.peek().type != T_EOF) {
             parseStatement();
         }
+        // Closed before the '}' is checked, so a block cut off by the end of
+        // the input does not leave its scope open.
+        depth--;
+        symTable.exitScope();
         expect(T_RBRACE);
     }
 
-    string parseExpression() {
-        string term = parseTerm();
-        while (tokens[pos].type == T_PLUS || tokens[pos].type == T_MINUS) {
-            TokenType op = tokens[pos++].type;
-            string nextTerm = parseTerm();
+    // Precedence climbing over BINARY_OPERATORS: each operator in a chain is
+    // one trip round the loop, and only a tighter-binding operator on the
+    // right recurses. Operators at the same level associate to the left.
+    string parseExpression(int minPrecedence = 1) {
+        string left = parseUnary();
+        for (;;) {
+            const BinaryOperator &op = BINARY_OPERATORS[tokens.peek().type];
+            if (op.precedence < minPrecedence) break;
+            tokens.nextToken();
+            string right = parseExpression(op.precedence + 1);
             string temp = icg.newTemp();
-            icg.addInstruction(temp + " = " + term + (op == T_PLUS ? " + " : " - ") + nextTerm);
-            term = temp;
+            icg.addInstruction(temp + " = " + left + " " + op.symbol + " " + right);
+            left = temp;
         }
-        if (tokens[pos].type == T_GT) {
-            pos++;
-            string nextExpr = parseExpression();
-            string temp = icg.newTemp();
-            icg.addInstruction(temp + " = " + term + " > " + nextExpr);
-            term = temp;
-        }
-        return term;
+        return left;
     }
 
-    string parseTerm() {
-        string factor = parseFactor();
-        while (tokens[pos].type == T_MUL || tokens[pos].type == T_DIV) {
-            TokenType op = tokens[pos++].type;
-            string nextFactor = parseFactor();
-            string temp = icg.newTemp();
-            icg.addInstruction(temp + " = " + factor + (op == T_MUL ? " * " : " / ") + nextFactor);
-            factor = temp;
+    // Prefix ! - & *, binding tighter than any binary operator.
+    string parseUnary() {
+        TokenType type = tokens.peek().type;
+        if (type != T_NOT && type != T_MINUS && type != T_AMP && type != T_MUL) {
+            return parseFactor();
         }
-        return factor;
+        string op = tokens.nextToken().value;
+        string operand = parseUnary();
+        string temp = icg.newTemp();
+        icg.addInstruction(temp + " = " + op + operand);
+        return temp;
     }
 
     string parseFactor() {
-        if (tokens[pos].type == T_NUM) {
-            return tokens[pos++].value;
-        } else if (tokens[pos].type == T_ID) {
-            return tokens[pos++].value;
-        } else if (tokens[pos].type == T_LPAREN) {
+        if (tokens.peek().type == T_NUM) {
+            return tokens.nextToken().value;
+        } else if (tokens.peek().type == T_ID) {
+            return tokens.nextToken().value;
+        } else if (tokens.peek().type == T_LPAREN) {
             expect(T_LPAREN);
             string expr = parseExpression();
             expect(T_RPAREN);
             return expr;
         } else {
-            cout << "Syntax error: unexpected token '" << tokens[pos].value << "' at line " << tokens[pos].lineNumber << endl;
-            exit(1);
+            throw runtime_error("Syntax error: unexpected token '" + tokens.peek().value + "' at line " +
+                                to_string(tokens.peek().lineNumber));
         }
     }
 
     void expect(TokenType type) {
-        if (tokens[pos].type != type) {
-            cout << "Syntax error: expected '" << type << "' at line " << tokens[pos].lineNumber << endl;
-            exit(1);
+        if (tokens.peek().type != type) {
+            throw runtime_error("Syntax error: expected '" + to_string(type) + "' at line " +
+                                to_string(tokens.peek().lineNumber));
         }
-        pos++;
+        tokens.nextToken();
     }
 
     string expectAndReturnValue(TokenType type) {
-        string value = tokens[pos].value;
+        string value = tokens.peek().value;
         expect(type);
         return value;
     }
@@ -376,7 +505,7 @@ int main() {
     return x;
     )";
     Lexer lexer(src);
-    vector<Token> tokens = lexer.tokenize();
+    TokenStream<Lexer> tokens(lexer);
 
     SymbolTable symTable;
     IntermediateCodeGnerator icg;
@@ -385,5 +514,5 @@ int main() {
     parser.parseProgram();
     icg.printInstructions();
 
-    return 0;
+    return parser.errorCount() ? 1 : 0;
 }
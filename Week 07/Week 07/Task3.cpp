@@ -5,6 +5,8 @@
 #include <string>
 #include <cctype>
 #include <stdexcept>
+#include "../../common/keyword_table.h"
+#include "../../common/token_span.h"
 
 using namespace std;
 
@@ -79,19 +81,11 @@ public:
             word += src[pos++];
         }
         // Recognize the new data types
-        if (word == "int")
-            return Token(T_INT, word, line);
-        if (word == "float")
-            return Token(T_FLOAT, word, line);
-        if (word == "double")
-            return Token(T_DOUBLE, word, line);
-        if (word == "string")
-            return Token(T_STRING, word, line);
-        if (word == "bool")
-            return Token(T_BOOL, word, line);
-        if (word == "char")
-            return Token(T_CHAR, word, line);
-        return Token(T_ID, word, line);
+        static constexpr auto keywords = makeKeywordTable<TokenType>({
+            {"int", T_INT}, {"float", T_FLOAT}, {"double", T_DOUBLE},
+            {"string", T_STRING}, {"bool", T_BOOL}, {"char", T_CHAR}
+        });
+        return Token(keywords.find(word, T_ID), word, line);
     }
 
     Token consumeStringLiteral()
@@ -180,10 +174,10 @@ public:
 class Parser
 {
 private:
-    vector<Token> tokens;
+    TokenSpan<Token> tokens;  // The caller's vector, not a copy
     size_t pos;
 
-    Token current_token()
+    const Token &current_token()
     {
         return tokens[pos];
     }
@@ -207,7 +201,7 @@ private:
     }
 
 public:
-    Parser(const vector<Token> &tok) : tokens(tok), pos(0) {}
+    Parser(TokenSpan<Token> tok) : tokens(tok), pos(0) {}
 
     void parseProgram()
     {
@@ -5,6 +5,8 @@
 #include <string>
 #include <cctype>
 #include <stdexcept>
+#include "../../common/keyword_table.h"
+#include "../../common/token_span.h"
 
 using namespace std;
 
@@ -71,35 +73,11 @@ public:
         {
             word += src[pos++];
         }
-        if (word == "int")
-        {
-            return Token(T_INT, word, line); // Match the 'int' keyword
-        }
-        else if (word == "float")
-        {
-            return Token(T_FLOAT, word, line);
-        }
-        else if (word == "double")
-        {
-            return Token(T_DOUBLE, word, line);
-        }
-        else if (word == "string")
-        {
-            return Token(T_STRING, word, line);
-        }
-        else if (word == "bool")
-        {
-            return Token(T_BOOL, word, line);
-        }
-        else if (word == "char")
-        {
-            return Token(T_CHAR, word, line);
-        }
-        else if (word == "true" || word == "false")
-        {
-            return Token(T_BOOL_LIT, word, line);
-        }
-        return Token(T_ID, word, line);
+        static constexpr auto keywords = makeKeywordTable<TokenType>({
+            {"int", T_INT}, {"float", T_FLOAT}, {"double", T_DOUBLE}, {"string", T_STRING},
+            {"bool", T_BOOL}, {"char", T_CHAR}, {"true", T_BOOL_LIT}, {"false", T_BOOL_LIT}
+        });
+        return Token(keywords.find(word, T_ID), word, line);
     }
 
     Token consumeString()
@@ -227,10 +205,11 @@ public:
 class Parser
 {
 private:
-    vector<Token> tokens;
+    TokenSpan<Token> tokens;  // The caller's vector, not a copy
     size_t pos;
+    int errors = 0;
 
-    Token current_token()
+    const Token &current_token()
     {
         return tokens[pos];
     }
@@ -255,8 +234,10 @@ private:
     }
 
 public:
-    Parser(const vector<Token> &tok) : tokens(tok), pos(0) {}
+    Parser(TokenSpan<Token> tok) : tokens(tok), pos(0) {}
 
+    // A statement with an error is reported and skipped (see synchronize), so
+    // one run reports every error in the program.
     void parseProgram()
     {
         while (current_token().type != T_EOF)
@@ -265,7 +246,49 @@ public:
         }
     }
 
+    int errorCount() const
+    {
+        return errors;
+    }
+
+    // Errors are thrown out of whatever the statement was in the middle of.
     void parseStatement()
+    {
+        try
+        {
+            parseStatementOrThrow();
+        }
+        catch (const runtime_error &e)
+        {
+            cerr << "Parsing error: " << e.what() << endl;
+            errors++;
+            synchronize();
+        }
+    }
+
+    // Panic mode: skips the rest of the broken statement, up to and including
+    // its ';', or up to a token that can only start a statement.
+    void synchronize()
+    {
+        while (current_token().type != T_EOF)
+        {
+            TokenType type = current_token().type;
+            if (type == T_SEMICOLON)
+            {
+                advance();
+                return;
+            }
+            // Float literals are T_FLOAT too; only the keyword starts a statement.
+            if (type == T_INT || (type == T_FLOAT && current_token().value == "float") || type == T_DOUBLE ||
+                type == T_STRING || type == T_BOOL || type == T_CHAR || type == T_AGAR)
+            {
+                return;
+            }
+            advance();
+        }
+    }
+
+    void parseStatementOrThrow()
     {
         if (current_token().type == T_INT || current_token().type == T_FLOAT || 
             current_token().type == T_DOUBLE || current_token().type == T_STRING || 
@@ -384,15 +407,12 @@ int main()
 
     // Step 2: Parse the tokenized input
     Parser parser(tokens);
-    try
+    parser.parseProgram();
+    if (parser.errorCount() == 0)
     {
-        parser.parseProgram();
         cout << "Parsing completed successfully!" << endl;
+        return 0;
     }
-    catch (const runtime_error &e)
-    {
-        cerr << "Parsing error: " << e.what() << endl;
-    }
-
-    return 0;
+    cerr << "Parsing failed with " << parser.errorCount() << " error" << (parser.errorCount() == 1 ? "" : "s") << endl;
+    return 1;
 }
@@ -3,6 +3,8 @@
 #include <string>
 #include <cctype>
 #include <stdexcept>
+#include "../../common/keyword_table.h"
+#include "../../common/token_span.h"
 
 using namespace std;
 // Token types enumeration
@@ -58,11 +60,8 @@ public:
         {
             word += src[pos++];
         }
-        if (word == "int")
-        {
-            return Token(T_INT, word); // Match the 'int' keyword
-        }
-        return Token(T_ID, word);
+        static constexpr auto keywords = makeKeywordTable<TokenType>({{"int", T_INT}});
+        return Token(keywords.find(word, T_ID), word);
     }
 
     vector<Token> tokenize()
@@ -127,10 +126,10 @@ public:
 class Parser
 {
 private:
-    vector<Token> tokens;
+    TokenSpan<Token> tokens;  // The caller's vector, not a copy
     size_t pos;
 
-    Token current_token()
+    const Token &current_token()
     {
         return tokens[pos];
     }
@@ -154,7 +153,7 @@ private:
     }
 
 public:
-    Parser(const vector<Token> &tok) : tokens(tok), pos(0) {}
+    Parser(TokenSpan<Token> tok) : tokens(tok), pos(0) {}
 
     void parseProgram()
     {
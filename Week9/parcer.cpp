@@ -3,17 +3,36 @@
 #include <string>
 #include <cctype>
 #include <map>
-#include <unordered_map>
 #include <fstream>
+#include <array>
+#include <stdexcept>
+#include "../common/simd_scan.h"
+#include "../common/keyword_table.h"
+#include "../common/token_stream.h"
+#include "../common/interner.h"
+#include "../common/scoped_symbol_table.h"
 
 using namespace std;
 
 enum TokenType {
     T_INT, T_FLOAT, T_DOUBLE, T_STRING, T_BOOL, T_CHAR, T_ID, T_NUM, T_IF, T_ELSE, T_RETURN, T_WHILE, T_FOR, T_ASSIGN,
     T_PLUS, T_MINUS, T_MUL, T_DIV, T_LPAREN, T_RPAREN, T_LBRACE, T_RBRACE, T_SEMICOLON, T_GT, T_LT, T_TRUE, T_FALSE,
-    T_EQ, T_NEQ, T_AND, T_OR, T_EOF, T_Cout
+    T_EQ, T_NEQ, T_AND, T_OR, T_EOF, T_Cout, T_MOD, T_LE, T_GE, T_NOT, T_AMP
 };
 
+// Binding power of each binary operator, indexed by token type; 0 for tokens
+// that are not one. `*` and `-` are also unary, which parseUnary handles.
+static constexpr array<int, T_AMP + 1> PRECEDENCE = [] {
+    array<int, T_AMP + 1> table{};
+    table[T_OR] = 1;
+    table[T_AND] = 2;
+    table[T_EQ] = table[T_NEQ] = 3;
+    table[T_LT] = table[T_LE] = table[T_GT] = table[T_GE] = 4;
+    table[T_PLUS] = table[T_MINUS] = 5;
+    table[T_MUL] = table[T_DIV] = table[T_MOD] = 6;
+    return table;
+}();
+
 struct Token {
     TokenType type;
     string value;
@@ -44,7 +63,7 @@ public:
     string consumeString() {
         pos++;
         size_t start = pos;
-        while (pos < src.size() && src[pos] != '"') pos++;
+        pos = simd::findByte(src.data() + pos, src.data() + src.size(), '"') - src.data();
         if (pos >= src.size()) {
             cout << "Unterminated string literal at line " << line << endl;
             exit(1);
@@ -67,145 +86,207 @@ public:
 
     vector<Token> tokenizer() {
         vector<Token> tokens;
+        do {
+            tokens.push_back(nextToken());
+        } while (tokens.back().type != T_EOF);
+        return tokens;
+    }
+
+    // Scans one token; T_EOF at the end of input (and on every call after).
+    Token nextToken() {
         while (pos < src.size()) {
             char current = src[pos];
 
             if (isspace(current)) {
-                if (current == '\n') line++;
-                pos++;
+                size_t newlines = 0;
+                const char *lastNewline = nullptr;
+                pos = simd::skipWhitespace(src.data() + pos, src.data() + src.size(), newlines, lastNewline) - src.data();
+                line += newlines;
                 continue;
             }
 
             if (current == '/' && pos + 1 < src.size() && src[pos + 1] == '/') {
-                while (pos < src.size() && src[pos] != '\n') pos++;
+                pos = simd::findByte(src.data() + pos, src.data() + src.size(), '\n') - src.data();
                 continue;
             }
 
             if (isdigit(current)) {
-                tokens.push_back(Token{T_NUM, consumeNumber(), line});
-                continue;
+                return Token{T_NUM, consumeNumber(), line};
             }
 
             if (isalpha(current)) {
+                static constexpr auto keywords = makeKeywordTable<TokenType>({
+                    {"int", T_INT}, {"float", T_FLOAT}, {"double", T_DOUBLE}, {"string", T_STRING},
+                    {"bool", T_BOOL}, {"char", T_CHAR}, {"agar", T_IF}, {"else", T_ELSE},
+                    {"return", T_RETURN}, {"while", T_WHILE}, {"for", T_FOR}, {"true", T_TRUE},
+                    {"false", T_FALSE}, {"cout", T_Cout}
+                });
                 string word = consumeWord();
-                if (word == "int") tokens.push_back(Token{T_INT, word, line});
-                else if (word == "float") tokens.push_back(Token{T_FLOAT, word, line});
-                else if (word == "double") tokens.push_back(Token{T_DOUBLE, word, line});
-                else if (word == "string") tokens.push_back(Token{T_STRING, word, line});
-                else if (word == "bool") tokens.push_back(Token{T_BOOL, word, line});
-                else if (word == "char") tokens.push_back(Token{T_CHAR, word, line});
-                else if (word == "agar") tokens.push_back(Token{T_IF, word, line});
-                else if (word == "else") tokens.push_back(Token{T_ELSE, word, line});
-                else if (word == "return") tokens.push_back(Token{T_RETURN, word, line});
-                else if (word == "while") tokens.push_back(Token{T_WHILE, word, line});
-                else if (word == "for") tokens.push_back(Token{T_FOR, word, line});
-                else if (word == "true") tokens.push_back(Token{T_TRUE, word, line});
-                else if (word == "false") tokens.push_back(Token{T_FALSE, word, line});
-                else if (word == "cout") tokens.push_back(Token{T_Cout, word, line});
-                else tokens.push_back(Token{T_ID, word, line});
-                continue;
+                return Token{keywords.find(word, T_ID), word, line};
             }
 
             if (current == '"') {
-                tokens.push_back(Token{T_STRING, consumeString(), line});
-                continue;
+                return Token{T_STRING, consumeString(), line};
             }
             if (current == '\'') {
-                tokens.push_back(Token{T_CHAR, string(1, consumeChar()), line});
-                continue;
+                return Token{T_CHAR, string(1, consumeChar()), line};
             }
 
+            Token token;
             switch (current) {
                 case '=':
                     if (pos + 1 < src.size() && src[pos + 1] == '=') {
-                        tokens.push_back(Token{T_EQ, "==", line});
+                        token = Token{T_EQ, "==", line};
                         pos += 2;
                     } else {
-                        tokens.push_back(Token{T_ASSIGN, "=", line});
+                        token = Token{T_ASSIGN, "=", line};
                         pos++;
                     }
                     break;
                 case '!':
                     if (pos + 1 < src.size() && src[pos + 1] == '=') {
-                        tokens.push_back(Token{T_NEQ, "!=", line});
+                        token = Token{T_NEQ, "!=", line};
                         pos += 2;
                     } else {
-                        cout << "Unexpected character: " << current << " at line " << line << endl;
-                        exit(1);
+                        token = Token{T_NOT, "!", line};
+                        pos++;
                     }
                     break;
                 case '&':
                     if (pos + 1 < src.size() && src[pos + 1] == '&') {
-                        tokens.push_back(Token{T_AND, "&&", line});
+                        token = Token{T_AND, "&&", line};
                         pos += 2;
                     } else {
-                        cout << "Unexpected character: " << current << " at line " << line << endl;
-                        exit(1);
+                        token = Token{T_AMP, "&", line};
+                        pos++;
                     }
                     break;
                 case '|':
                     if (pos + 1 < src.size() && src[pos + 1] == '|') {
-                        tokens.push_back(Token{T_OR, "||", line});
+                        token = Token{T_OR, "||", line};
                         pos += 2;
                     } else {
                         cout << "Unexpected character: " << current << " at line " << line << endl;
                         exit(1);
                     }
                     break;
-                case '+': tokens.push_back(Token{T_PLUS, "+", line}); pos++; break;
-                case '-': tokens.push_back(Token{T_MINUS, "-", line}); pos++; break;
-                case '*': tokens.push_back(Token{T_MUL, "*", line}); pos++; break;
-                case '/': tokens.push_back(Token{T_DIV, "/", line}); pos++; break;
-                case '(': tokens.push_back(Token{T_LPAREN, "(", line}); pos++; break;
-                case ')': tokens.push_back(Token{T_RPAREN, ")", line}); pos++; break;
-                case '{': tokens.push_back(Token{T_LBRACE, "{", line}); pos++; break;
-                case '}': tokens.push_back(Token{T_RBRACE, "}", line}); pos++; break;
-                case ';': tokens.push_back(Token{T_SEMICOLON, ";", line}); pos++; break;
-                case '>': tokens.push_back(Token{T_GT, ">", line}); pos++; break;
-                case '<': tokens.push_back(Token{T_LT, "<", line}); pos++; break;
+                case '+': token = Token{T_PLUS, "+", line}; pos++; break;
+                case '-': token = Token{T_MINUS, "-", line}; pos++; break;
+                case '*': token = Token{T_MUL, "*", line}; pos++; break;
+                case '/': token = Token{T_DIV, "/", line}; pos++; break;
+                case '(': token = Token{T_LPAREN, "(", line}; pos++; break;
+                case ')': token = Token{T_RPAREN, ")", line}; pos++; break;
+                case '{': token = Token{T_LBRACE, "{", line}; pos++; break;
+                case '}': token = Token{T_RBRACE, "}", line}; pos++; break;
+                case ';': token = Token{T_SEMICOLON, ";", line}; pos++; break;
+                case '%': token = Token{T_MOD, "%", line}; pos++; break;
+                case '>':
+                    if (pos + 1 < src.size() && src[pos + 1] == '=') {
+                        token = Token{T_GE, ">=", line};
+                        pos += 2;
+                    } else {
+                        token = Token{T_GT, ">", line};
+                        pos++;
+                    }
+                    break;
+                case '<':
+                    if (pos + 1 < src.size() && src[pos + 1] == '=') {
+                        token = Token{T_LE, "<=", line};
+                        pos += 2;
+                    } else {
+                        token = Token{T_LT, "<", line};
+                        pos++;
+                    }
+                    break;
                 default:
                     cout << "Unexpected character: " << current << " at line " << line << endl;
                     exit(1);
             }
+            return token;
         }
-        tokens.push_back(Token{T_EOF, "", line});
-        return tokens;
+        return Token{T_EOF, "", line};
     }
 };
 
 class Parser {
 private:
-    vector<Token> tokens;
-    size_t pos;
-    unordered_map<string, TokenType> symbolTable;
+    TokenStream<Lexer> &tokens;  // Pulled on demand; see common/token_stream.h
+    Interner names;
+    ScopedSymbolTable<TokenType> symbolTable;  // Declared type, by block
+    int errors = 0;
+    int depth = 0;  // Blocks open around the current statement
 
 public:
-    Parser(const vector<Token> &tokens) : tokens(tokens), pos(0) {}
+    Parser(TokenStream<Lexer> &tokens) : tokens(tokens) {}
 
+    // A statement with an error is reported and skipped (see synchronize), so
+    // one run reports every error in the program.
     void parseProgram() {
-        while (tokens[pos].type != T_EOF) {
+        while (tokens.peek().type != T_EOF) {
             parseStatement();
         }
-        cout << "Parsing completed successfully! No syntax errors." << endl;
+        if (errors == 0) {
+            cout << "Parsing completed successfully! No syntax errors." << endl;
+        } else {
+            cout << "Parsing completed with " << errors << " syntax error" << (errors == 1 ? "" : "s") << "." << endl;
+        }
     }
 
+    int errorCount() const {
+        return errors;
+    }
+
+    // reportError throws out of whatever the statement was in the middle of.
     void parseStatement() {
-        if (tokens[pos].type == T_INT || tokens[pos].type == T_FLOAT || tokens[pos].type == T_DOUBLE ||
-            tokens[pos].type == T_STRING || tokens[pos].type == T_BOOL || tokens[pos].type == T_CHAR) {
+        try {
+            parseStatementOrThrow();
+        } catch (const runtime_error &e) {
+            cout << e.what() << endl;
+            errors++;
+            synchronize();
+        }
+    }
+
+    // Panic mode: skips the rest of the broken statement, up to and including
+    // its ';', or up to the '}' closing the enclosing block or a token that
+    // can only start a statement. A '}' with no block open is skipped too, so
+    // every error moves the parser forward.
+    void synchronize() {
+        for (;;) {
+            switch (tokens.peek().type) {
+                case T_EOF: case T_INT: case T_FLOAT: case T_DOUBLE: case T_STRING: case T_BOOL: case T_CHAR:
+                case T_IF: case T_WHILE: case T_FOR: case T_RETURN: case T_LBRACE: case T_Cout:
+                    return;
+                case T_SEMICOLON:
+                    tokens.nextToken();
+                    return;
+                case T_RBRACE:
+                    if (depth > 0) return;
+                    tokens.nextToken();
+                    break;
+                default:
+                    tokens.nextToken();
+            }
+        }
+    }
+
+    void parseStatementOrThrow() {
+        if (tokens.peek().type == T_INT || tokens.peek().type == T_FLOAT || tokens.peek().type == T_DOUBLE ||
+            tokens.peek().type == T_STRING || tokens.peek().type == T_BOOL || tokens.peek().type == T_CHAR) {
             parseDeclaration();
-        } else if (tokens[pos].type == T_Cout) {
+        } else if (tokens.peek().type == T_Cout) {
             parseAssignment();
-        } else if (tokens[pos].type == T_ID) {
+        } else if (tokens.peek().type == T_ID) {
             parseAssignment();
-        } else if (tokens[pos].type == T_IF) {
+        } else if (tokens.peek().type == T_IF) {
             parseIfStatement();
-        } else if (tokens[pos].type == T_WHILE) {
+        } else if (tokens.peek().type == T_WHILE) {
             parseWhileStatement();
-        } else if (tokens[pos].type == T_FOR) {
+        } else if (tokens.peek().type == T_FOR) {
             parseForStatement();
-        } else if (tokens[pos].type == T_RETURN) {
+        } else if (tokens.peek().type == T_RETURN) {
             parseReturnStatement();
-        } else if (tokens[pos].type == T_LBRACE) {
+        } else if (tokens.peek().type == T_LBRACE) {
             parseBlock();
         } else {
             reportError("Unexpected token");
@@ -214,28 +295,32 @@ public:
 
     void parseBlock() {
         expect(T_LBRACE);
-        while (tokens[pos].type != T_RBRACE && tokens[pos].type != T_EOF) {
+        symbolTable.enterScope();
+        depth++;
+        while (tokens.peek().type != T_RBRACE && tokens.peek().type != T_EOF) {
             parseStatement();
         }
+        // Closed before the '}' is checked, so a block cut off by the end of
+        // the input does not leave its scope open.
+        depth--;
+        symbolTable.exitScope();
         expect(T_RBRACE);
     }
 
     void parseDeclaration() {
-        TokenType varType = tokens[pos].type;
-        pos++;
+        TokenType varType = tokens.nextToken().type;
         
-        if (tokens[pos].type != T_ID) {
+        if (tokens.peek().type != T_ID) {
             reportError("Expected variable name after type");
         }
         
-        string varName = tokens[pos].value;
+        string varName = tokens.peek().value;
         
-        if (symbolTable.find(varName) != symbolTable.end()) {
+        if (!symbolTable.declare(names.intern(varName), varType)) {
             reportError("Variable '" + varName + "' redeclared");
         }
         
-        symbolTable[varName] = varType;
-        pos++;
+        tokens.nextToken();
         expect(T_ASSIGN);
         parseExpression();
         expect(T_SEMICOLON);
@@ -244,11 +329,11 @@ public:
     }
 
     void parseAssignment() {
-        string varName = tokens[pos].value;
-        if (symbolTable.find(varName) == symbolTable.end()) {
+        string varName = tokens.peek().value;
+        if (!symbolTable.lookup(names.intern(varName))) {
             reportError("Variable '" + varName + "' not declared");
         }
-        pos++;
+        tokens.nextToken();
         expect(T_ASSIGN);
         parseExpression();
         expect(T_SEMICOLON);
@@ -260,8 +345,8 @@ public:
         parseExpression();
         expect(T_RPAREN);
         parseStatement();
-        if (tokens[pos].type == T_ELSE) {
-            pos++;
+        if (tokens.peek().type == T_ELSE) {
+            tokens.nextToken();
             parseStatement();
         }
     }
@@ -292,19 +377,31 @@ public:
         expect(T_SEMICOLON);
     }
 
-    void parseExpression() {
-        parsePrimary();
-        while (tokens[pos].type == T_PLUS || tokens[pos].type == T_MINUS || tokens[pos].type == T_MUL || tokens[pos].type == T_DIV) {
-            pos++;
-            parsePrimary();
+    // Precedence climbing over PRECEDENCE: each operator in a chain is one
+    // trip round the loop, and only a tighter-binding operator on the right
+    // recurses.
+    void parseExpression(int minPrecedence = 1) {
+        parseUnary();
+        for (int precedence; (precedence = PRECEDENCE[tokens.peek().type]) >= minPrecedence;) {
+            tokens.nextToken();
+            parseExpression(precedence + 1);
         }
     }
 
+    // Prefix ! - & *, binding tighter than any binary operator.
+    void parseUnary() {
+        while (tokens.peek().type == T_NOT || tokens.peek().type == T_MINUS || tokens.peek().type == T_AMP ||
+               tokens.peek().type == T_MUL) {
+            tokens.nextToken();
+        }
+        parsePrimary();
+    }
+
     void parsePrimary() {
-        if (tokens[pos].type == T_NUM || tokens[pos].type == T_ID) {
-            pos++;
-        } else if (tokens[pos].type == T_LPAREN) {
-            pos++;
+        if (tokens.peek().type == T_NUM || tokens.peek().type == T_ID) {
+            tokens.nextToken();
+        } else if (tokens.peek().type == T_LPAREN) {
+            tokens.nextToken();
             parseExpression();
             expect(T_RPAREN);
         } else {
@@ -313,16 +410,16 @@ public:
     }
 
     void expect(TokenType expectedType) {
-        if (tokens[pos].type == expectedType) {
-            pos++;
+        if (tokens.peek().type == expectedType) {
+            tokens.nextToken();
         } else {
             reportError("Unexpected token");
         }
     }
 
-    void reportError(const string &message) {
-        cout << "Syntax error: " << message << " at token '" << tokens[pos].value << "' on line " << tokens[pos].line << endl;
-        exit(1);
+    [[noreturn]] void reportError(const string &message) {
+        throw runtime_error("Syntax error: " + message + " at token '" + tokens.peek().value + "' on line " +
+                            to_string(tokens.peek().line));
     }
 };
 
@@ -336,15 +433,18 @@ int main() {
         }
     )";
 
-    Lexer lexer(source_code);
-    vector<Token> tokens = lexer.tokenizer();
-
-    for (const auto &token : tokens) {
+    // The listing and the parser each pull from their own lexer, so neither
+    // keeps the whole token list.
+    Lexer listing(source_code);
+    for (Token token = listing.nextToken();; token = listing.nextToken()) {
         cout << "Token: " << token.value << " Type: " << token.type << " Line: " << token.line << endl;
+        if (token.type == T_EOF) break;
     }
 
+    Lexer lexer(source_code);
+    TokenStream<Lexer> tokens(lexer);
     Parser parser(tokens);
     parser.parseProgram();
 
-    return 0;
+    return parser.errorCount() ? 1 : 0;
 }
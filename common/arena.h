@@ -0,0 +1,187 @@
+#ifndef COMMON_ARENA_H
+#define COMMON_ARENA_H
+
+// Bump allocator for data that lives exactly as long as one compilation.
+//
+// Small allocations are carved from 2 MB blocks; nothing is freed one by one
+// except the most recent allocation (so a vector growing at the end of the
+// arena can shrink back) and allocations larger than a quarter block, which
+// get their own block and are returned when deallocated. Everything else goes
+// in one shot when the arena is destroyed. With hugePages set, blocks are
+// mapped on Linux with MADV_HUGEPAGE so the kernel can back them with 2 MB
+// pages; elsewhere the flag is ignored.
+//
+// ArenaAllocator adapts an Arena for standard containers. A null arena falls
+// back to the global heap, so the same container type works with or without
+// one:
+//
+//     Arena arena;
+//     ArenaVector<Token> tokens{ArenaAllocator<Token>(&arena)};
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string_view>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+class Arena {
+public:
+    static const size_t BLOCK_SIZE = 2 << 20;
+
+    explicit Arena(bool hugePages = false) : hugePages(hugePages) {}
+
+    ~Arena() {
+        for (const Block &block : blocks) release(block);
+    }
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    void *allocate(size_t bytes, size_t align = alignof(std::max_align_t)) {
+        allocations++;
+        if (bytes > BLOCK_SIZE / 4) {
+            blocks.push_back(acquire(bytes));
+            return blocks.back().start;
+        }
+        size_t pad = (size_t)(-(uintptr_t)pos) & (align - 1);
+        if (pad + bytes > left) {
+            blocks.push_back(acquire(BLOCK_SIZE));
+            pos = blocks.back().start;
+            left = BLOCK_SIZE;
+            pad = 0;
+        }
+        char *p = pos + pad;
+        pos = p + bytes;
+        left -= pad + bytes;
+        return p;
+    }
+
+    void deallocate(void *p, size_t bytes) {
+        if (bytes > BLOCK_SIZE / 4) {
+            // Recent blocks are the likely ones.
+            for (size_t i = blocks.size(); i-- > 0;) {
+                if (blocks[i].start == p) {
+                    release(blocks[i]);
+                    blocks.erase(blocks.begin() + i);
+                    return;
+                }
+            }
+            return;
+        }
+        if ((char *)p + bytes == pos) {
+            left += bytes;
+            pos = (char *)p;
+        }
+    }
+
+    // Copies `text` into the arena.
+    std::string_view store(std::string_view text) {
+        if (text.empty()) return std::string_view();
+        char *copy = (char *)allocate(text.size(), 1);
+        std::memcpy(copy, text.data(), text.size());
+        return std::string_view(copy, text.size());
+    }
+
+    // Calls to allocate(), and blocks obtained from the system, so far.
+    size_t allocationCount() const {
+        return allocations;
+    }
+
+    size_t blockCount() const {
+        return acquired;
+    }
+
+    size_t bytesReserved() const {
+        size_t total = 0;
+        for (const Block &block : blocks) total += block.size;
+        return total;
+    }
+
+private:
+    struct Block {
+        char *start;
+        size_t size;
+        bool mapped;
+    };
+
+    bool hugePages;
+    std::vector<Block> blocks;
+    char *pos = nullptr;
+    size_t left = 0;
+    size_t allocations = 0;
+    size_t acquired = 0;
+
+    Block acquire(size_t size) {
+        acquired++;
+#ifdef __linux__
+        if (hugePages) {
+            size = (size + BLOCK_SIZE - 1) & ~(BLOCK_SIZE - 1);
+            void *p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED) throw std::bad_alloc();
+            madvise(p, size, MADV_HUGEPAGE);
+            return {(char *)p, size, true};
+        }
+#endif
+        return {(char *)::operator new(size), size, false};
+    }
+
+    static void release(const Block &block) {
+#ifdef __linux__
+        if (block.mapped) {
+            munmap(block.start, block.size);
+            return;
+        }
+#endif
+        ::operator delete(block.start);
+    }
+};
+
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    ArenaAllocator(Arena *arena = nullptr) : arena(arena) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other) : arena(other.arena) {}
+
+    T *allocate(size_t n) {
+        if (!arena) return (T *)::operator new(n * sizeof(T));
+        return (T *)arena->allocate(n * sizeof(T), alignof(T));
+    }
+
+    void deallocate(T *p, size_t n) {
+        if (!arena) {
+            ::operator delete(p);
+            return;
+        }
+        arena->deallocate(p, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U> &other) const {
+        return arena == other.arena;
+    }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U> &other) const {
+        return arena != other.arena;
+    }
+
+private:
+    template <typename U>
+    friend class ArenaAllocator;
+
+    Arena *arena;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+#endif
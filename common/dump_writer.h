@@ -0,0 +1,101 @@
+#ifndef COMMON_DUMP_WRITER_H
+#define COMMON_DUMP_WRITER_H
+
+// Buffered text output for the compiler's dumps (tokens, symbols, IR,
+// assembly).
+//
+// Text is formatted straight into one reusable buffer and handed to the
+// stream in large writes, instead of going through ostream formatting and
+// an endl flush per line. Integers are formatted with to_chars; padded()
+// right-aligns a field the way setw does.
+//
+//     DumpWriter out(cout);
+//     out << "line " << 42 << '\n';
+//     out.padded(name, 15) << " | ";
+//     // Flushed when `out` is destroyed, or by flush()
+
+#include <charconv>
+#include <cstddef>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+class DumpWriter {
+public:
+    explicit DumpWriter(std::ostream &out, size_t capacity = 1 << 20) : out(out), buffer(capacity) {}
+
+    ~DumpWriter() {
+        flush();
+    }
+
+    DumpWriter(const DumpWriter &) = delete;
+    DumpWriter &operator=(const DumpWriter &) = delete;
+
+    DumpWriter &operator<<(std::string_view text) {
+        if (text.size() > buffer.size() - used) {
+            flushBuffer();
+            if (text.size() > buffer.size()) {
+                out.write(text.data(), (std::streamsize)text.size());
+                written += text.size();
+                return *this;
+            }
+        }
+        std::char_traits<char>::copy(buffer.data() + used, text.data(), text.size());
+        used += text.size();
+        return *this;
+    }
+
+    DumpWriter &operator<<(const char *text) {
+        return *this << std::string_view(text);
+    }
+
+    DumpWriter &operator<<(char c) {
+        if (used == buffer.size()) flushBuffer();
+        buffer[used++] = c;
+        return *this;
+    }
+
+    template <typename Integer, typename = std::enable_if_t<std::is_integral_v<Integer>>>
+    DumpWriter &operator<<(Integer value) {
+        char text[24];
+        return *this << std::string_view(text, std::to_chars(text, text + sizeof(text), value).ptr - text);
+    }
+
+    // `text` right-aligned in a field of `width` characters, as with setw.
+    DumpWriter &padded(std::string_view text, size_t width) {
+        for (size_t i = text.size(); i < width; ++i) *this << ' ';
+        return *this << text;
+    }
+
+    template <typename Integer, typename = std::enable_if_t<std::is_integral_v<Integer>>>
+    DumpWriter &padded(Integer value, size_t width) {
+        char text[24];
+        return padded(std::string_view(text, std::to_chars(text, text + sizeof(text), value).ptr - text), width);
+    }
+
+    // Bytes written so far, buffered or not.
+    size_t bytesWritten() const {
+        return written + used;
+    }
+
+    // Writes out everything buffered and flushes the stream.
+    void flush() {
+        flushBuffer();
+        out.flush();
+    }
+
+private:
+    std::ostream &out;
+    std::vector<char> buffer;
+    size_t used = 0;
+    size_t written = 0;
+
+    void flushBuffer() {
+        if (used) out.write(buffer.data(), (std::streamsize)used);
+        written += used;
+        used = 0;
+    }
+};
+
+#endif
@@ -0,0 +1,134 @@
+#ifndef COMMON_INTERNER_H
+#define COMMON_INTERNER_H
+
+// String interner: maps each distinct string to a dense 32-bit id.
+//
+// The bytes of every interned string are copied once into large chunks, so
+// the views returned by name() stay valid for the interner's lifetime. The
+// lookup table is open addressing with linear probing over ids; it stores
+// each string's hash alongside the id, so probing skips most mismatches
+// without touching the bytes and growing the table never rehashes strings.
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+class Interner {
+public:
+    static const uint32_t NOT_FOUND = 0xFFFFFFFFu;
+
+    Interner() {
+        slots.assign(INITIAL_SLOTS, Slot());
+    }
+
+    Interner(const Interner &) = delete;
+    Interner &operator=(const Interner &) = delete;
+
+    // Returns the id for `text`, adding it if it is new. Ids are handed out
+    // in order of first appearance, starting at 0.
+    uint32_t intern(std::string_view text) {
+        uint32_t hash = hashOf(text);
+        size_t mask = slots.size() - 1;
+        for (size_t i = hash & mask;; i = (i + 1) & mask) {
+            Slot &slot = slots[i];
+            if (slot.id == NOT_FOUND) {
+                uint32_t id = (uint32_t)names.size();
+                names.push_back(store(text));
+                slot.hash = hash;
+                slot.id = id;
+                if (names.size() * 4 > slots.size() * 3) grow();
+                return id;
+            }
+            if (slot.hash == hash && names[slot.id] == text) return slot.id;
+        }
+    }
+
+    // Returns the id for `text`, or NOT_FOUND without adding it.
+    uint32_t find(std::string_view text) const {
+        uint32_t hash = hashOf(text);
+        size_t mask = slots.size() - 1;
+        for (size_t i = hash & mask;; i = (i + 1) & mask) {
+            const Slot &slot = slots[i];
+            if (slot.id == NOT_FOUND) return NOT_FOUND;
+            if (slot.hash == hash && names[slot.id] == text) return slot.id;
+        }
+    }
+
+    std::string_view name(uint32_t id) const {
+        return names[id];
+    }
+
+    size_t size() const {
+        return names.size();
+    }
+
+    // Bytes held by the string chunks, for memory reports.
+    size_t bytesReserved() const {
+        return reserved;
+    }
+
+    static uint32_t hashOf(std::string_view text) {
+        // FNV-1a, folded to 32 bits.
+        uint64_t h = 1469598103934665603ull;
+        for (unsigned char c : text) {
+            h ^= c;
+            h *= 1099511628211ull;
+        }
+        return (uint32_t)(h ^ (h >> 32));
+    }
+
+private:
+    static const size_t INITIAL_SLOTS = 1024;
+    static const size_t CHUNK_SIZE = 64 * 1024;
+
+    struct Slot {
+        uint32_t hash = 0;
+        uint32_t id = NOT_FOUND;
+    };
+
+    std::vector<Slot> slots;
+    std::vector<std::string_view> names;
+    std::vector<std::unique_ptr<char[]>> chunks;
+    char *chunkPos = nullptr;
+    size_t chunkLeft = 0;
+    size_t reserved = 0;
+
+    std::string_view store(std::string_view text) {
+        if (text.size() > CHUNK_SIZE / 4) {
+            // Long strings get their own block so they don't waste a chunk tail.
+            // The current chunk stays current.
+            chunks.emplace_back(new char[text.size()]);
+            reserved += text.size();
+            std::memcpy(chunks.back().get(), text.data(), text.size());
+            return std::string_view(chunks.back().get(), text.size());
+        }
+        if (text.size() > chunkLeft) {
+            chunks.emplace_back(new char[CHUNK_SIZE]);
+            chunkPos = chunks.back().get();
+            chunkLeft = CHUNK_SIZE;
+            reserved += CHUNK_SIZE;
+        }
+        if (!text.empty()) std::memcpy(chunkPos, text.data(), text.size());
+        std::string_view stored(chunkPos, text.size());
+        chunkPos += text.size();
+        chunkLeft -= text.size();
+        return stored;
+    }
+
+    void grow() {
+        std::vector<Slot> old;
+        old.swap(slots);
+        slots.assign(old.size() * 2, Slot());
+        size_t mask = slots.size() - 1;
+        for (const Slot &slot : old) {
+            if (slot.id == NOT_FOUND) continue;
+            size_t i = slot.hash & mask;
+            while (slots[i].id != NOT_FOUND) i = (i + 1) & mask;
+            slots[i] = slot;
+        }
+    }
+};
+
+#endif
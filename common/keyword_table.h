@@ -0,0 +1,107 @@
+#ifndef COMMON_KEYWORD_TABLE_H
+#define COMMON_KEYWORD_TABLE_H
+
+// Compile-time perfect hash for keyword recognition.
+//
+// The hash only looks at the word's length and its first and last bytes, so
+// computing it is a few multiplies no matter how long the identifier is. The
+// constructor searches for multipliers that put every keyword in its own slot;
+// it runs during constant evaluation, so a keyword set with no perfect hash is
+// a compile error, not a runtime surprise. A lookup is one slot probe and one
+// memcmp:
+//
+//     static constexpr auto keywords = makeKeywordTable<TokenType>({
+//         {"if", T_IF}, {"else", T_ELSE}, {"return", T_RETURN}
+//     });
+//     TokenType type = keywords.find(word, T_ID);
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+template <typename T>
+struct KeywordEntry {
+    std::string_view word;
+    T token;
+};
+
+template <typename T, size_t N>
+class KeywordTable {
+public:
+    // Four slots per keyword keeps the multiplier search short and the whole
+    // table within a few cache lines for typical keyword sets.
+    static constexpr size_t SIZE = [] {
+        size_t size = 1;
+        while (size < 4 * N) size <<= 1;
+        return size;
+    }();
+
+    constexpr explicit KeywordTable(const KeywordEntry<T> (&entries)[N]) {
+        for (size_t i = 0; i < N; ++i) {
+            size_t length = entries[i].word.size();
+            if (length == 0) throw "keywords must not be empty";
+            if (length < minLength) minLength = length;
+            if (length > maxLength) maxLength = length;
+        }
+
+        for (uint32_t a = 1; a < 256; ++a) {
+            for (uint32_t b = 1; b < 256; ++b) {
+                firstMultiplier = a;
+                lastMultiplier = b;
+                if (tryPlace(entries)) return;
+            }
+        }
+        throw "no perfect hash on (length, first, last) for this keyword set";
+    }
+
+    // Returns the keyword's token, or `fallback` if `word` is not a keyword.
+    T find(std::string_view word, T fallback) const {
+        size_t length = word.size();
+        if (length < minLength || length > maxLength) return fallback;
+        const Slot &slot = slots[hash(length, word.front(), word.back())];
+        if (slot.length == length && std::memcmp(slot.word, word.data(), length) == 0) {
+            return slot.token;
+        }
+        return fallback;
+    }
+
+private:
+    struct Slot {
+        const char *word = nullptr;
+        size_t length = 0;  // 0 marks an empty slot; keywords are never empty
+        T token{};
+    };
+
+    Slot slots[SIZE] = {};
+    size_t minLength = ~size_t(0);
+    size_t maxLength = 0;
+    uint32_t firstMultiplier = 0;
+    uint32_t lastMultiplier = 0;
+
+    constexpr size_t hash(size_t length, char first, char last) const {
+        uint32_t h = (uint32_t)(unsigned char)first * firstMultiplier +
+                     (uint32_t)(unsigned char)last * lastMultiplier + (uint32_t)length;
+        return (h ^ (h >> 7)) & (SIZE - 1);
+    }
+
+    constexpr bool tryPlace(const KeywordEntry<T> (&entries)[N]) {
+        for (size_t i = 0; i < SIZE; ++i) slots[i] = Slot{};
+        for (size_t i = 0; i < N; ++i) {
+            std::string_view word = entries[i].word;
+            Slot &slot = slots[hash(word.size(), word.front(), word.back())];
+            if (slot.length != 0) return false;
+            slot.word = word.data();
+            slot.length = word.size();
+            slot.token = entries[i].token;
+        }
+        return true;
+    }
+};
+
+template <typename T, size_t N>
+constexpr KeywordTable<T, N> makeKeywordTable(const KeywordEntry<T> (&entries)[N]) {
+    return KeywordTable<T, N>(entries);
+}
+
+#endif
@@ -0,0 +1,137 @@
+#ifndef COMMON_MAPPED_FILE_H
+#define COMMON_MAPPED_FILE_H
+
+// Read-only view of a whole input file.
+//
+// Regular files are memory-mapped so the lexer can scan the bytes in place.
+// Anything that cannot be mapped (stdin given as "-", pipes, character
+// devices, empty files) is read into an owned buffer instead; callers only
+// ever see view().
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+class MappedFile {
+public:
+    explicit MappedFile(const std::string &path) {
+        if (path == "-") {
+            readStream(stdin);
+            return;
+        }
+        if (!tryMap(path)) {
+            FILE *file = std::fopen(path.c_str(), "rb");
+            if (!file) {
+                throw std::runtime_error("Could not open file " + path);
+            }
+            readStream(file);
+            std::fclose(file);
+        }
+    }
+
+    ~MappedFile() {
+        unmap();
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    std::string_view view() const {
+        return mapped ? std::string_view(mapped, mappedSize) : std::string_view(fallback);
+    }
+
+    bool isMapped() const {
+        return mapped != nullptr;
+    }
+
+private:
+    const char *mapped = nullptr;
+    size_t mappedSize = 0;
+    std::string fallback;
+#ifdef _WIN32
+    HANDLE fileHandle = INVALID_HANDLE_VALUE;
+    HANDLE mappingHandle = nullptr;
+#endif
+
+    void readStream(FILE *stream) {
+        char buffer[1 << 16];
+        size_t n;
+        while ((n = std::fread(buffer, 1, sizeof(buffer), stream)) > 0) {
+            fallback.append(buffer, n);
+        }
+    }
+
+#ifdef _WIN32
+    bool tryMap(const std::string &path) {
+        fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                 OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER size;
+        if (GetFileType(fileHandle) != FILE_TYPE_DISK || !GetFileSizeEx(fileHandle, &size) || size.QuadPart == 0) {
+            unmap();
+            return false;
+        }
+        mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mappingHandle) {
+            unmap();
+            return false;
+        }
+        mapped = static_cast<const char *>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+        if (!mapped) {
+            unmap();
+            return false;
+        }
+        mappedSize = (size_t)size.QuadPart;
+        return true;
+    }
+
+    void unmap() {
+        if (mapped) UnmapViewOfFile(mapped);
+        if (mappingHandle) CloseHandle(mappingHandle);
+        if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+        mapped = nullptr;
+        mappingHandle = nullptr;
+        fileHandle = INVALID_HANDLE_VALUE;
+    }
+#else
+    bool tryMap(const std::string &path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+        void *addr = ::mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);  // The mapping keeps its own reference to the file
+        if (addr == MAP_FAILED) return false;
+
+        ::madvise(addr, (size_t)info.st_size, MADV_SEQUENTIAL);
+        mapped = static_cast<const char *>(addr);
+        mappedSize = (size_t)info.st_size;
+        return true;
+    }
+
+    void unmap() {
+        if (mapped) ::munmap(const_cast<char *>(mapped), mappedSize);
+        mapped = nullptr;
+    }
+#endif
+};
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef COMMON_NUMBER_LITERAL_H
+#define COMMON_NUMBER_LITERAL_H
+
+// Scans a C numeric literal and evaluates it in the same pass, so the lexer
+// can hand later phases a binary value instead of text.
+//
+//     integers   123  0x1F  017  with suffixes u, l, ll, ul, llu, ...
+//     floating   1.5  2.  1e9  6.02e+23  1.5e-3f  with suffix f or l
+//
+// A literal starts with a decimal digit and is the longest prefix matching
+// the forms above; "1e" is the integer 1 followed by whatever "e" starts, as
+// in Final Code & Report/tokens.l. Integers wrap modulo 2^64; a leading 0
+// means octal only when every digit is octal. Floating values are rounded
+// once, to float for an 'f' suffix and to double otherwise (long double is
+// evaluated as double). A floating literal outside the range of its type
+// evaluates to 0.
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+
+struct NumberLiteral {
+    bool floating = false;
+    bool singlePrecision = false;  // 'f' or 'F' suffix
+    uint64_t integer = 0;          // When !floating
+    double real = 0;               // When floating
+};
+
+namespace number_literal_detail {
+
+inline bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+inline int hexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// [uU](l|L|ll|LL)? | (l|L|ll|LL)[uU]?
+inline const char *integerSuffix(const char *p, const char *end) {
+    auto longs = [&](const char *q) {
+        if (q < end && (*q == 'l' || *q == 'L')) {
+            return q + 1 < end && q[1] == q[0] ? q + 2 : q + 1;
+        }
+        return q;
+    };
+    if (p < end && (*p == 'u' || *p == 'U')) return longs(p + 1);
+    const char *q = longs(p);
+    if (q != p && q < end && (*q == 'u' || *q == 'U')) ++q;
+    return q;
+}
+
+// [eE][+-]?[0-9]+, or `p` itself if no exponent starts there.
+inline const char *exponent(const char *p, const char *end) {
+    if (p >= end || (*p != 'e' && *p != 'E')) return p;
+    const char *q = p + 1;
+    if (q < end && (*q == '+' || *q == '-')) ++q;
+    if (q >= end || !isDigit(*q)) return p;
+    while (q < end && isDigit(*q)) ++q;
+    return q;
+}
+
+}  // namespace number_literal_detail
+
+// `p` must point at a decimal digit. Returns the end of the literal.
+inline const char *scanNumber(const char *p, const char *end, NumberLiteral &literal) {
+    using namespace number_literal_detail;
+    literal = NumberLiteral();
+    const char *begin = p;
+
+    if (p[0] == '0' && p + 2 < end && (p[1] == 'x' || p[1] == 'X') && hexDigit(p[2]) >= 0) {
+        uint64_t value = 0;
+        for (p += 2; p < end && hexDigit(*p) >= 0; ++p) value = value << 4 | (uint64_t)hexDigit(*p);
+        literal.integer = value;
+        return integerSuffix(p, end);
+    }
+
+    // Decimal digits, accumulated both ways until we know which applies.
+    uint64_t decimal = 0, octal = 0;
+    bool allOctal = true;
+    for (; p < end && isDigit(*p); ++p) {
+        decimal = decimal * 10 + (uint64_t)(*p - '0');
+        octal = octal * 8 + (uint64_t)(*p - '0');
+        allOctal &= *p < '8';
+    }
+
+    const char *digitsEnd = p;
+    if (p < end && *p == '.') {
+        ++p;
+        while (p < end && isDigit(*p)) ++p;
+    }
+    p = exponent(p, end);
+    if (p == digitsEnd) {
+        literal.integer = begin[0] == '0' && allOctal ? octal : decimal;
+        return integerSuffix(p, end);
+    }
+
+    literal.floating = true;
+    const char *mantissaEnd = p;
+    if (p < end && (*p == 'f' || *p == 'F')) {
+        literal.singlePrecision = true;
+        float value = 0;
+        std::from_chars(begin, mantissaEnd, value);
+        literal.real = value;
+        return p + 1;
+    }
+    std::from_chars(begin, mantissaEnd, literal.real);
+    return p < end && (*p == 'l' || *p == 'L') ? p + 1 : p;
+}
+
+#endif
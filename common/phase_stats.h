@@ -0,0 +1,151 @@
+#ifndef COMMON_PHASE_STATS_H
+#define COMMON_PHASE_STATS_H
+
+// Wall time and counters per compiler phase, printed as a table or as JSON.
+//
+// A Scope times one stretch of a phase with steady_clock and adds to the
+// phase's totals, so a phase may be entered more than once (output, say,
+// happens between other phases). Phases are listed in order of first entry.
+// Each phase records the process's peak RSS when it was last left, and how
+// much the peak grew while it ran: the growth column adds up to the rise
+// over the whole compilation and points at the phase that allocated it.
+//
+//     PhaseStats stats;
+//     {
+//         PhaseStats::Scope lexing = stats.enter("lexing");
+//         ...
+//         lexing.add(tokens, 0, source.size());
+//     }
+//     stats.printTable(cerr);
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+class PhaseStats {
+public:
+    struct Phase {
+        std::string name;
+        double seconds = 0;
+        uint64_t tokens = 0;
+        uint64_t instructions = 0;
+        uint64_t bytes = 0;
+        uint64_t peakRssBytes = 0;
+        uint64_t peakRssGrowthBytes = 0;
+    };
+
+    class Scope {
+    public:
+        Scope(PhaseStats &stats, size_t phase)
+            : stats(stats), phase(phase), peakBefore(peakRssBytes()), start(std::chrono::steady_clock::now()) {}
+
+        ~Scope() {
+            Phase &p = stats.phases[phase];
+            p.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            p.peakRssBytes = peakRssBytes();
+            p.peakRssGrowthBytes += p.peakRssBytes - peakBefore;
+        }
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+        // Tokens and instructions handled, and bytes read or written.
+        void add(uint64_t tokens, uint64_t instructions, uint64_t bytes) {
+            Phase &p = stats.phases[phase];
+            p.tokens += tokens;
+            p.instructions += instructions;
+            p.bytes += bytes;
+        }
+
+    private:
+        PhaseStats &stats;
+        size_t phase;
+        uint64_t peakBefore;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    PhaseStats() : start(std::chrono::steady_clock::now()) {}
+
+    Scope enter(const std::string &name) {
+        for (size_t i = 0; i < phases.size(); ++i) {
+            if (phases[i].name == name) return Scope(*this, i);
+        }
+        phases.push_back(Phase());
+        phases.back().name = name;
+        return Scope(*this, phases.size() - 1);
+    }
+
+    const std::vector<Phase> &all() const {
+        return phases;
+    }
+
+    // Since construction, including anything between phases.
+    double totalSeconds() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void printTable(std::ostream &out) const {
+        out << std::left << std::setw(16) << "Phase" << std::right << std::setw(12) << "Time (ms)" << std::setw(12)
+            << "Tokens" << std::setw(14) << "Instructions" << std::setw(14) << "Bytes" << std::setw(15)
+            << "Peak RSS (MB)" << std::setw(11) << "Growth" << "\n";
+        for (const Phase &p : phases) {
+            out << std::left << std::setw(16) << p.name << std::right << std::fixed << std::setprecision(3)
+                << std::setw(12) << p.seconds * 1e3 << std::setw(12) << p.tokens << std::setw(14) << p.instructions
+                << std::setw(14) << p.bytes << std::setprecision(1) << std::setw(15) << p.peakRssBytes / 1048576.0
+                << std::setw(11) << p.peakRssGrowthBytes / 1048576.0 << "\n";
+        }
+        out << std::left << std::setw(16) << "total" << std::right << std::setprecision(3) << std::setw(12)
+            << totalSeconds() * 1e3 << std::setw(55) << std::setprecision(1) << peakRssBytes() / 1048576.0 << "\n";
+        out.flush();
+    }
+
+    void printJson(std::ostream &out) const {
+        out << "{\"phases\": [";
+        for (size_t i = 0; i < phases.size(); ++i) {
+            const Phase &p = phases[i];
+            out << (i ? ", " : "") << "{\"name\": \"" << p.name << "\", \"seconds\": " << std::setprecision(9)
+                << p.seconds << ", \"tokens\": " << p.tokens << ", \"instructions\": " << p.instructions
+                << ", \"bytes\": " << p.bytes << ", \"peakRssBytes\": " << p.peakRssBytes
+                << ", \"peakRssGrowthBytes\": " << p.peakRssGrowthBytes << "}";
+        }
+        out << "], \"totalSeconds\": " << totalSeconds() << ", \"peakRssBytes\": " << peakRssBytes() << "}\n";
+        out.flush();
+    }
+
+    // High-water mark of the process's resident set, or 0 if unknown.
+    static uint64_t peakRssBytes() {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+        return counters.PeakWorkingSetSize;
+#else
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+        return (uint64_t)usage.ru_maxrss;  // Bytes on macOS
+#else
+        return (uint64_t)usage.ru_maxrss * 1024;  // Kilobytes on Linux
+#endif
+#endif
+    }
+
+private:
+    std::vector<Phase> phases;
+    std::chrono::steady_clock::time_point start;
+};
+
+#endif
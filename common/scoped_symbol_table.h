@@ -0,0 +1,137 @@
+#ifndef COMMON_SCOPED_SYMBOL_TABLE_H
+#define COMMON_SCOPED_SYMBOL_TABLE_H
+
+// Block-scoped symbol table keyed by interned names (see interner.h).
+//
+// An open-addressing table maps each name to its innermost visible binding.
+// Bindings live on one stack that doubles as the undo log: a binding records
+// the one it shadows, and leaving a scope pops the bindings made since it was
+// entered, restoring what they shadowed. So exitScope() costs only the
+// declarations of the scope being left, and lookup() is a hash probe plus an
+// index, however deep the nesting.
+//
+//     ScopedSymbolTable<TypeInfo> symbols;
+//     symbols.declare(interner.intern("x"), intType);
+//     symbols.enterScope();
+//     symbols.declare(interner.intern("x"), floatType);  // Shadows the outer x
+//     symbols.exitScope();                                 // Outer x is back
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+template <typename Info>
+class ScopedSymbolTable {
+public:
+    ScopedSymbolTable() {
+        slots.assign(INITIAL_SLOTS, Slot());
+        scopeStarts.push_back(0);
+    }
+
+    void enterScope() {
+        scopeStarts.push_back(bindings.size());
+    }
+
+    // Leaves the innermost scope; the global scope is never left.
+    void exitScope() {
+        if (scopeStarts.size() == 1) return;
+        size_t start = scopeStarts.back();
+        scopeStarts.pop_back();
+        while (bindings.size() > start) {
+            const Binding &binding = bindings.back();
+            slots[findSlot(binding.name)].binding = binding.shadowed;
+            bindings.pop_back();
+        }
+    }
+
+    // 0 for the global scope.
+    size_t depth() const {
+        return scopeStarts.size() - 1;
+    }
+
+    // Declares `name` in the innermost scope, shadowing any outer binding.
+    // Returns false, changing nothing, if this scope already declares it.
+    bool declare(uint32_t name, const Info &info) {
+        size_t slot = findSlot(name);
+        if (slots[slot].name == NONE) {
+            slots[slot].name = name;
+            used++;
+        }
+        uint32_t current = slots[slot].binding;
+        if (current != NONE && current >= scopeStarts.back()) return false;
+
+        bindings.push_back({info, name, current});
+        slots[slot].binding = (uint32_t)(bindings.size() - 1);
+        if (used * 2 > slots.size()) grow();
+        return true;
+    }
+
+    // The innermost visible binding of `name`, or nullptr.
+    const Info *lookup(uint32_t name) const {
+        uint32_t binding = slots[findSlot(name)].binding;
+        return binding == NONE ? nullptr : &bindings[binding].info;
+    }
+
+    Info *lookup(uint32_t name) {
+        uint32_t binding = slots[findSlot(name)].binding;
+        return binding == NONE ? nullptr : &bindings[binding].info;
+    }
+
+    bool declaredInCurrentScope(uint32_t name) const {
+        uint32_t binding = slots[findSlot(name)].binding;
+        return binding != NONE && binding >= scopeStarts.back();
+    }
+
+    // Bindings visible or shadowed right now, across all open scopes.
+    size_t size() const {
+        return bindings.size();
+    }
+
+private:
+    static const uint32_t NONE = 0xFFFFFFFFu;
+    static const size_t INITIAL_SLOTS = 256;
+
+    // A slot keeps its name once used, even with no binding left, so probing
+    // never needs tombstones. Names are interned, so there are few of them.
+    struct Slot {
+        uint32_t name = NONE;
+        uint32_t binding = NONE;
+    };
+
+    struct Binding {
+        Info info;
+        uint32_t name;
+        uint32_t shadowed;  // Binding index this one hides, or NONE
+    };
+
+    std::vector<Slot> slots;
+    std::vector<Binding> bindings;
+    std::vector<size_t> scopeStarts;  // bindings.size() at each enterScope()
+    size_t used = 0;
+
+    // Interned ids are dense small integers. Multiplying by an odd constant is
+    // a bijection modulo the table size, so any run of table-size consecutive
+    // ids lands in distinct slots and a lookup is normally a single probe.
+    size_t home(uint32_t name) const {
+        return (size_t)(name * 2654435769u) & (slots.size() - 1);
+    }
+
+    // The slot holding `name`, or the empty slot where it would go.
+    size_t findSlot(uint32_t name) const {
+        size_t mask = slots.size() - 1;
+        size_t i = home(name);
+        while (slots[i].name != name && slots[i].name != NONE) i = (i + 1) & mask;
+        return i;
+    }
+
+    void grow() {
+        std::vector<Slot> old;
+        old.swap(slots);
+        slots.assign(old.size() * 2, Slot());
+        for (const Slot &slot : old) {
+            if (slot.name != NONE) slots[findSlot(slot.name)] = slot;
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,301 @@
+#ifndef COMMON_SIMD_SCAN_H
+#define COMMON_SIMD_SCAN_H
+
+// Vectorised byte scanning for the lexers' hot loops.
+//
+// Each routine has a scalar, an SSE2 (16 bytes per step) and an AVX2 (32 bytes
+// per step) version. The widest version the CPU supports is picked once, on
+// first use, from CPUID; level() reports it and setLevel() lets benchmarks
+// force a narrower one. Non-x86 builds only get the scalar code.
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SIMD_SCAN_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define SIMD_SCAN_AVX2_TARGET
+#else
+#include <cpuid.h>
+#define SIMD_SCAN_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SIMD_SCAN_SSE2 1
+#endif
+#endif
+
+namespace simd {
+
+enum Level { SCALAR, SSE2, AVX2 };
+
+namespace detail {
+
+inline unsigned popcount32(uint32_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_popcount(x);
+#else
+    x = x - ((x >> 1) & 0x55555555u);
+    x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+    return (((x + (x >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24;
+#endif
+}
+
+// Index of the lowest / highest set bit; x must be non-zero.
+inline unsigned lowestBit(uint32_t x) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, x);
+    return (unsigned)index;
+#else
+    return (unsigned)__builtin_ctz(x);
+#endif
+}
+
+inline unsigned highestBit(uint32_t x) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanReverse(&index, x);
+    return (unsigned)index;
+#else
+    return 31u - (unsigned)__builtin_clz(x);
+#endif
+}
+
+// Same set as isspace() in the "C" locale.
+inline bool isSpace(char c) {
+    return c == ' ' || (unsigned char)(c - '\t') < 5;
+}
+
+// Newlines found in `mask` (bit i = byte p[i]) are added to the running count
+// and the last one is remembered for column tracking.
+inline void countNewlines(const char *p, uint32_t mask, size_t &newlines, const char *&lastNewline) {
+    if (mask) {
+        newlines += popcount32(mask);
+        lastNewline = p + highestBit(mask);
+    }
+}
+
+inline const char *skipWhitespaceScalar(const char *p, const char *end, size_t &newlines, const char *&lastNewline) {
+    for (; p < end && isSpace(*p); ++p) {
+        if (*p == '\n') {
+            ++newlines;
+            lastNewline = p;
+        }
+    }
+    return p;
+}
+
+inline const char *findByteScalar(const char *p, const char *end, char c) {
+    while (p < end && *p != c) ++p;
+    return p;
+}
+
+inline const char *findEitherScalar(const char *p, const char *end, char a, char b) {
+    while (p < end && *p != a && *p != b) ++p;
+    return p;
+}
+
+#ifdef SIMD_SCAN_SSE2
+inline const char *skipWhitespaceSse2(const char *p, const char *end, size_t &newlines, const char *&lastNewline) {
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i four = _mm_set1_epi8(4);
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i newline = _mm_set1_epi8('\n');
+    while (end - p >= 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        // '\t'..'\r' is a contiguous range: (c - '\t') <= 4 as an unsigned byte.
+        __m128i shifted = _mm_sub_epi8(chunk, tab);
+        __m128i inRange = _mm_cmpeq_epi8(_mm_min_epu8(shifted, four), shifted);
+        __m128i isWs = _mm_or_si128(inRange, _mm_cmpeq_epi8(chunk, space));
+        uint32_t wsMask = (uint32_t)_mm_movemask_epi8(isWs);
+        uint32_t nlMask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline));
+        if (wsMask != 0xFFFFu) {
+            unsigned stop = lowestBit(~wsMask);
+            countNewlines(p, nlMask & ((1u << stop) - 1), newlines, lastNewline);
+            return p + stop;
+        }
+        countNewlines(p, nlMask, newlines, lastNewline);
+        p += 16;
+    }
+    return skipWhitespaceScalar(p, end, newlines, lastNewline);
+}
+
+inline const char *findByteSse2(const char *p, const char *end, char c) {
+    const __m128i needle = _mm_set1_epi8(c);
+    while (end - p >= 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle));
+        if (mask) return p + lowestBit(mask);
+        p += 16;
+    }
+    return findByteScalar(p, end, c);
+}
+
+inline const char *findEitherSse2(const char *p, const char *end, char a, char b) {
+    const __m128i first = _mm_set1_epi8(a);
+    const __m128i second = _mm_set1_epi8(b);
+    while (end - p >= 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(chunk, first), _mm_cmpeq_epi8(chunk, second));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(hits);
+        if (mask) return p + lowestBit(mask);
+        p += 16;
+    }
+    return findEitherScalar(p, end, a, b);
+}
+#endif
+
+#ifdef SIMD_SCAN_X86
+SIMD_SCAN_AVX2_TARGET
+inline const char *skipWhitespaceAvx2(const char *p, const char *end, size_t &newlines, const char *&lastNewline) {
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i four = _mm256_set1_epi8(4);
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i newline = _mm256_set1_epi8('\n');
+    while (end - p >= 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+        __m256i shifted = _mm256_sub_epi8(chunk, tab);
+        __m256i inRange = _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, four), shifted);
+        __m256i isWs = _mm256_or_si256(inRange, _mm256_cmpeq_epi8(chunk, space));
+        uint32_t wsMask = (uint32_t)_mm256_movemask_epi8(isWs);
+        uint32_t nlMask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, newline));
+        if (wsMask != 0xFFFFFFFFu) {
+            unsigned stop = lowestBit(~wsMask);
+            countNewlines(p, nlMask & ((1u << stop) - 1), newlines, lastNewline);
+            return p + stop;
+        }
+        countNewlines(p, nlMask, newlines, lastNewline);
+        p += 32;
+    }
+    return skipWhitespaceScalar(p, end, newlines, lastNewline);
+}
+
+SIMD_SCAN_AVX2_TARGET
+inline const char *findByteAvx2(const char *p, const char *end, char c) {
+    const __m256i needle = _mm256_set1_epi8(c);
+    while (end - p >= 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle));
+        if (mask) return p + lowestBit(mask);
+        p += 32;
+    }
+    return findByteScalar(p, end, c);
+}
+
+SIMD_SCAN_AVX2_TARGET
+inline const char *findEitherAvx2(const char *p, const char *end, char a, char b) {
+    const __m256i first = _mm256_set1_epi8(a);
+    const __m256i second = _mm256_set1_epi8(b);
+    while (end - p >= 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+        __m256i hits = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, first), _mm256_cmpeq_epi8(chunk, second));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(hits);
+        if (mask) return p + lowestBit(mask);
+        p += 32;
+    }
+    return findEitherScalar(p, end, a, b);
+}
+
+// AVX2 needs both the CPUID feature bit and OS support for saving the YMM
+// registers (OSXSAVE plus the SSE/AVX bits of XCR0).
+inline bool cpuHasAvx2() {
+    unsigned eax, ebx, ecx, edx;
+#if defined(_MSC_VER) && !defined(__clang__)
+    int regs[4];
+    __cpuid(regs, 1);
+    ecx = (unsigned)regs[2];
+    if (!(ecx & (1u << 27))) return false;
+    if ((_xgetbv(0) & 6) != 6) return false;
+    __cpuidex(regs, 7, 0);
+    ebx = (unsigned)regs[1];
+#else
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & (1u << 27))) return false;
+    unsigned xcr0Low, xcr0High;
+    __asm__("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+    if ((xcr0Low & 6) != 6) return false;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return false;
+#endif
+    return (ebx & (1u << 5)) != 0;
+}
+#endif
+
+inline Level detectLevel() {
+#ifdef SIMD_SCAN_X86
+    if (cpuHasAvx2()) return AVX2;
+#endif
+#ifdef SIMD_SCAN_SSE2
+    return SSE2;
+#else
+    return SCALAR;
+#endif
+}
+
+inline Level &currentLevel() {
+    static Level level = detectLevel();
+    return level;
+}
+
+} // namespace detail
+
+inline Level level() {
+    return detail::currentLevel();
+}
+
+// Forces a narrower implementation (a wider one than the CPU supports is
+// ignored). Not thread-safe; meant for benchmarks.
+inline void setLevel(Level requested) {
+    if (requested <= detail::detectLevel()) detail::currentLevel() = requested;
+}
+
+inline const char *levelName(Level l) {
+    return l == AVX2 ? "avx2" : l == SSE2 ? "sse2" : "scalar";
+}
+
+// Returns the first byte in [p, end) that isspace() rejects. Newlines crossed
+// on the way are added to `newlines`, and `lastNewline` is set to the last of
+// them (left untouched if there were none).
+inline const char *skipWhitespace(const char *p, const char *end, size_t &newlines, const char *&lastNewline) {
+    switch (detail::currentLevel()) {
+#ifdef SIMD_SCAN_X86
+        case AVX2: return detail::skipWhitespaceAvx2(p, end, newlines, lastNewline);
+#endif
+#ifdef SIMD_SCAN_SSE2
+        case SSE2: return detail::skipWhitespaceSse2(p, end, newlines, lastNewline);
+#endif
+        default: return detail::skipWhitespaceScalar(p, end, newlines, lastNewline);
+    }
+}
+
+// Returns the first occurrence of `c` in [p, end), or `end`. Used to jump
+// over comment bodies.
+inline const char *findByte(const char *p, const char *end, char c) {
+    switch (detail::currentLevel()) {
+#ifdef SIMD_SCAN_X86
+        case AVX2: return detail::findByteAvx2(p, end, c);
+#endif
+#ifdef SIMD_SCAN_SSE2
+        case SSE2: return detail::findByteSse2(p, end, c);
+#endif
+        default: return detail::findByteScalar(p, end, c);
+    }
+}
+
+// Returns the first occurrence of `a` or `b` in [p, end), or `end`. Used to
+// jump over the plain runs of string literals (to the next quote or escape).
+inline const char *findEither(const char *p, const char *end, char a, char b) {
+    switch (detail::currentLevel()) {
+#ifdef SIMD_SCAN_X86
+        case AVX2: return detail::findEitherAvx2(p, end, a, b);
+#endif
+#ifdef SIMD_SCAN_SSE2
+        case SSE2: return detail::findEitherSse2(p, end, a, b);
+#endif
+        default: return detail::findEitherScalar(p, end, a, b);
+    }
+}
+
+} // namespace simd
+
+#endif
@@ -0,0 +1,127 @@
+#ifndef COMMON_THREAD_POOL_H
+#define COMMON_THREAD_POOL_H
+
+// Fixed-size pool of std::threads for data-parallel loops.
+//
+//     ThreadPool pool(8);
+//     pool.parallelFor(chunks.size(), [&](size_t i) { lex(chunks[i]); });
+//
+// parallelFor hands out indices through an atomic counter, the calling thread
+// works alongside the pool, and the call returns once every index is done.
+// The first exception thrown by a task is rethrown to the caller.
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+    // `threads` counts the calling thread, so ThreadPool(1) starts no workers.
+    explicit ThreadPool(size_t threads = defaultThreads()) {
+        for (size_t i = 1; i < std::max<size_t>(threads, 1); ++i) {
+            workers.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread &worker : workers) worker.join();
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    size_t size() const {
+        return workers.size() + 1;
+    }
+
+    static size_t defaultThreads() {
+        unsigned n = std::thread::hardware_concurrency();
+        return n ? n : 1;
+    }
+
+    template <typename Task>
+    void parallelFor(size_t count, Task task) {
+        if (count == 0) return;
+        if (workers.empty() || count == 1) {
+            for (size_t i = 0; i < count; ++i) task(i);
+            return;
+        }
+
+        std::function<void(size_t)> body = task;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = &body;
+            jobSize = count;
+            next = 0;
+            pending = count;
+            error = nullptr;
+            generation++;
+        }
+        wake.notify_all();
+
+        runTasks();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return pending == 0; });
+        job = nullptr;
+        if (error) std::rethrow_exception(error);
+    }
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    bool stopping = false;
+    size_t generation = 0;
+
+    std::function<void(size_t)> *job = nullptr;
+    size_t jobSize = 0;
+    std::atomic<size_t> next{0};
+    size_t pending = 0;  // Guarded by mutex
+    std::exception_ptr error;
+
+    void runTasks() {
+        size_t finished = 0;
+        for (size_t i; (i = next.fetch_add(1)) < jobSize;) {
+            try {
+                (*job)(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) error = std::current_exception();
+            }
+            finished++;
+        }
+        if (finished) {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending -= finished;
+            if (pending == 0) done.notify_all();
+        }
+    }
+
+    void workerLoop() {
+        size_t seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || (generation != seen && job); });
+                if (stopping) return;
+                seen = generation;
+            }
+            runTasks();
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,430 @@
+#ifndef COMMON_TOKEN_CACHE_H
+#define COMMON_TOKEN_CACHE_H
+
+// On-disk cache of a lexer's output, so an unchanged source is not lexed again.
+//
+// A cache file belongs to one source text: its name is the source's content
+// hash, and its header repeats the hash and the size. The file is read by
+// memory-mapping it, and TokenCacheReader decodes the tokens in order
+// straight from the mapping, so loading costs one mmap and a header check.
+//
+//     header     TokenCacheHeader
+//     kinds      TokenCacheKind[256]    how tokens of each kind are stored
+//     tokens     uint8_t[tokenBytes]    per token: its kind, then varints
+//     lines      uint8_t[lineBytes]     TokenCacheLine entries, as varint deltas
+//     numbers    uint8_t[numberBytes]   values of numeric and character literals, varints in order
+//     decoded    TokenCacheDecoded[decodedCount]
+//     nameEnds   uint32_t[nameCount]    end of each name in `strings`
+//     strings    char[stringBytes]      names, then decoded literal values
+//
+// A token is its kind byte, the gap from the end of the previous token to its
+// start (zigzag), its length unless the kind has a fixed one, and its
+// cache-local name id + 1 if the kind has names (0 for none). Offsets are
+// sums of lengths and gaps, which are mostly a byte each, so the cache is
+// smaller than the source. Token values are not stored: they are slices of
+// the source, except literals whose escapes were decoded. Lines and columns
+// are stored as a line table; see TokenCacheLine. A cache is only meant for
+// the machine that wrote it: fixed-width fields are in native byte order.
+//
+//     TokenCacheFile cache;
+//     if (cache.open(tokenCachePath(directory, source), source)) ...  // Hit
+//     else writeTokenCache(tokenCachePath(directory, source), source, data);
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mapped_file.h"
+
+// 64-bit hash of the whole text, 8 bytes at a time. Not cryptographic: a
+// cache hit also requires the sizes to match.
+inline uint64_t contentHash(std::string_view text) {
+    const uint64_t M = 0x9E3779B97F4A7C15ull;
+    uint64_t h = 0x243F6A8885A308D3ull ^ (text.size() * M);
+    const char *p = text.data();
+    size_t n = text.size();
+    for (; n >= 8; p += 8, n -= 8) {
+        uint64_t word;
+        std::memcpy(&word, p, 8);
+        h = (h ^ word) * M;
+        h ^= h >> 29;
+    }
+    uint64_t tail = 0;
+    std::memcpy(&tail, p, n);
+    h = (h ^ tail) * M;
+    h ^= h >> 32;
+    h *= 0xD6E8FEB86659FD93ull;
+    return h ^ (h >> 32);
+}
+
+// The tokens from `firstToken` up to the next entry share a line, and their
+// column is offset + length - bias, modulo 2^32. An entry starts wherever
+// either changes.
+struct TokenCacheLine {
+    uint32_t firstToken;
+    int32_t line;
+    uint32_t bias;
+};
+
+// A `length` of 0 means each token of the kind stores its own; otherwise
+// every token of the kind has this length. `named`: its tokens store a name.
+struct TokenCacheKind {
+    uint8_t length;
+    uint8_t named;
+};
+
+// Value of token `token` is strings[begin, begin + length).
+struct TokenCacheDecoded {
+    uint32_t token;
+    uint32_t begin;
+    uint32_t length;
+};
+
+struct TokenCacheHeader {
+    static constexpr uint32_t VERSION = 3;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t sourceHash;
+    uint64_t sourceSize;
+    uint32_t tokenCount;
+    uint32_t lineCount;
+    uint32_t decodedCount;
+    uint32_t nameCount;
+    uint32_t tokenBytes;
+    uint32_t lineBytes;
+    uint32_t numberBytes;
+    uint32_t stringBytes;
+};
+
+// Everything a cache file holds besides the header, one entry per token (or
+// line, number, ...) as the writer collects it. writeTokenCache packs it.
+struct TokenCacheData {
+    static constexpr uint32_t NO_NAME = 0xFFFFFFFFu;
+
+    std::vector<uint8_t> kinds;
+    std::vector<uint32_t> symbols;
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> lengths;
+    std::vector<TokenCacheLine> lines;
+    std::vector<uint64_t> numbers;
+    std::vector<TokenCacheDecoded> decoded;
+    std::vector<uint32_t> nameEnds;
+    std::string strings;
+};
+
+namespace token_cache_detail {
+
+inline const char MAGIC[8] = {'K', 'T', 'O', 'K', 'E', 'N', 'S', '\0'};
+
+inline size_t align8(size_t n) {
+    return (n + 7) & ~(size_t)7;
+}
+
+// Byte offset of each section, in file order, and the total file size.
+struct Layout {
+    size_t kinds, tokens, lines, numbers, decoded, nameEnds, strings, end;
+
+    explicit Layout(const TokenCacheHeader &h) {
+        kinds = align8(sizeof(TokenCacheHeader));
+        tokens = align8(kinds + 256 * sizeof(TokenCacheKind));
+        lines = tokens + h.tokenBytes;
+        numbers = lines + h.lineBytes;
+        decoded = align8(numbers + h.numberBytes);
+        nameEnds = align8(decoded + h.decodedCount * sizeof(TokenCacheDecoded));
+        strings = align8(nameEnds + h.nameCount * sizeof(uint32_t));
+        end = strings + h.stringBytes;
+    }
+};
+
+// Seven bits a byte, low first; the high bit says another byte follows.
+inline void putVarint(std::string &out, uint64_t value) {
+    while (value >= 0x80) {
+        out += (char)(value | 0x80);
+        value >>= 7;
+    }
+    out += (char)value;
+}
+
+inline uint64_t getVarint(const uint8_t *&p) {
+    uint64_t value = *p & 0x7F;
+    for (int shift = 7; *p++ & 0x80; shift += 7) value |= (uint64_t)(*p & 0x7F) << shift;
+    return value;
+}
+
+// Small differences of either sign as small unsigned numbers.
+inline uint64_t zigzag(int64_t value) {
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+inline int64_t unzigzag(uint64_t value) {
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+// A fixed length for each kind whose tokens all have the same one, and
+// whether any token of the kind has a name.
+inline void chooseKinds(const TokenCacheData &data, TokenCacheKind *kinds) {
+    bool seen[256] = {};
+    bool varies[256] = {};
+    for (size_t i = 0; i < data.kinds.size(); ++i) {
+        uint8_t kind = data.kinds[i];
+        if (!seen[kind]) {
+            seen[kind] = true;
+            kinds[kind].length = data.lengths[i] < 256 ? (uint8_t)data.lengths[i] : 0;
+        } else if (kinds[kind].length != data.lengths[i]) {
+            varies[kind] = true;
+        }
+        if (data.symbols[i] != TokenCacheData::NO_NAME) kinds[kind].named = 1;
+    }
+    for (int kind = 0; kind < 256; ++kind) {
+        if (varies[kind]) kinds[kind].length = 0;
+    }
+}
+
+// The tokens, lines and numbers sections.
+inline void pack(const TokenCacheData &data, const TokenCacheKind *kinds, std::string &tokens, std::string &lines,
+                 std::string &numbers) {
+    uint64_t end = 0;
+    for (size_t i = 0; i < data.kinds.size(); ++i) {
+        const TokenCacheKind &kind = kinds[data.kinds[i]];
+        tokens += (char)data.kinds[i];
+        putVarint(tokens, zigzag((int64_t)data.offsets[i] - (int64_t)end));
+        if (!kind.length) putVarint(tokens, data.lengths[i]);
+        if (kind.named) putVarint(tokens, (uint64_t)data.symbols[i] + 1);
+        end = (uint64_t)data.offsets[i] + data.lengths[i];
+    }
+    TokenCacheLine previous{};
+    for (const TokenCacheLine &line : data.lines) {
+        putVarint(lines, line.firstToken - previous.firstToken);
+        putVarint(lines, zigzag((int64_t)line.line - previous.line));
+        putVarint(lines, zigzag((int32_t)(line.bias - previous.bias)));
+        previous = line;
+    }
+    for (uint64_t number : data.numbers) putVarint(numbers, number);
+}
+
+}  // namespace token_cache_detail
+
+// Cache file for `source` in `directory`: the content hash in hex.
+inline std::string tokenCachePath(const std::string &directory, std::string_view source) {
+    static const char digits[] = "0123456789abcdef";
+    uint64_t hash = contentHash(source);
+    std::string name(16, '0');
+    for (int i = 15; i >= 0; --i, hash >>= 4) name[i] = digits[hash & 15];
+    return (std::filesystem::path(directory) / (name + ".tokens")).string();
+}
+
+// Writes the cache for `source`, creating the directory if needed. The file
+// is written under a temporary name and renamed into place, so a reader
+// never maps a half-written cache. Returns false if anything fails; a
+// missing cache only costs a relex.
+inline bool writeTokenCache(const std::string &path, std::string_view source, const TokenCacheData &data) {
+    using namespace token_cache_detail;
+
+    TokenCacheKind kinds[256] = {};
+    chooseKinds(data, kinds);
+    std::string tokens, lines, numbers;
+    pack(data, kinds, tokens, lines, numbers);
+
+    TokenCacheHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = TokenCacheHeader::VERSION;
+    header.headerSize = sizeof(TokenCacheHeader);
+    header.sourceHash = contentHash(source);
+    header.sourceSize = source.size();
+    header.tokenCount = (uint32_t)data.kinds.size();
+    header.lineCount = (uint32_t)data.lines.size();
+    header.decodedCount = (uint32_t)data.decoded.size();
+    header.nameCount = (uint32_t)data.nameEnds.size();
+    header.tokenBytes = (uint32_t)tokens.size();
+    header.lineBytes = (uint32_t)lines.size();
+    header.numberBytes = (uint32_t)numbers.size();
+    header.stringBytes = (uint32_t)data.strings.size();
+    Layout layout(header);
+
+    std::vector<char> file(layout.end);
+    auto put = [&](size_t at, const void *bytes, size_t size) {
+        if (size) std::memcpy(file.data() + at, bytes, size);
+    };
+    put(0, &header, sizeof(header));
+    put(layout.kinds, kinds, sizeof(kinds));
+    put(layout.tokens, tokens.data(), tokens.size());
+    put(layout.lines, lines.data(), lines.size());
+    put(layout.numbers, numbers.data(), numbers.size());
+    put(layout.decoded, data.decoded.data(), data.decoded.size() * sizeof(TokenCacheDecoded));
+    put(layout.nameEnds, data.nameEnds.data(), data.nameEnds.size() * sizeof(uint32_t));
+    put(layout.strings, data.strings.data(), data.strings.size());
+
+    std::error_code error;
+    std::filesystem::path target(path);
+    if (target.has_parent_path()) std::filesystem::create_directories(target.parent_path(), error);
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out.write(file.data(), (std::streamsize)file.size())) return false;
+    }
+    std::filesystem::rename(temporary, target, error);
+    return !error;
+}
+
+// A mapped cache file, checked against the source it claims to describe.
+class TokenCacheFile {
+public:
+    // Maps `path` if it is a cache of exactly `source` in this version of the
+    // format. Returns false (and holds nothing) otherwise.
+    bool open(const std::string &path, std::string_view source) {
+        using namespace token_cache_detail;
+
+        file.reset();
+        std::error_code error;
+        if (!std::filesystem::is_regular_file(path, error)) return false;
+        try {
+            file = std::make_unique<MappedFile>(path);
+        } catch (const std::runtime_error &) {
+            return false;
+        }
+
+        std::string_view bytes = file->view();
+        if (bytes.size() < sizeof(TokenCacheHeader)) return reject();
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != TokenCacheHeader::VERSION ||
+            header.headerSize != sizeof(TokenCacheHeader) || header.sourceSize != source.size() ||
+            header.tokenCount == 0 || Layout(header).end != bytes.size() ||
+            header.sourceHash != contentHash(source)) {
+            return reject();
+        }
+        base = bytes.data();
+        layout = Layout(header);
+        return true;
+    }
+
+    const TokenCacheHeader &info() const {
+        return header;
+    }
+
+    const TokenCacheKind *kinds() const {
+        return section<TokenCacheKind>(&token_cache_detail::Layout::kinds);
+    }
+
+    const uint8_t *tokens() const {
+        return section<uint8_t>(&token_cache_detail::Layout::tokens);
+    }
+
+    const uint8_t *lines() const {
+        return section<uint8_t>(&token_cache_detail::Layout::lines);
+    }
+
+    const uint8_t *numbers() const {
+        return section<uint8_t>(&token_cache_detail::Layout::numbers);
+    }
+
+    const TokenCacheDecoded *decoded() const {
+        return section<TokenCacheDecoded>(&token_cache_detail::Layout::decoded);
+    }
+
+    // Cached name `id`, and a decoded literal value, as views into the file.
+    std::string_view name(uint32_t id) const {
+        const uint32_t *ends = section<uint32_t>(&token_cache_detail::Layout::nameEnds);
+        uint32_t begin = id ? ends[id - 1] : 0;
+        return std::string_view(strings() + begin, ends[id] - begin);
+    }
+
+    std::string_view value(const TokenCacheDecoded &decoded) const {
+        return std::string_view(strings() + decoded.begin, decoded.length);
+    }
+
+private:
+    std::unique_ptr<MappedFile> file;
+    TokenCacheHeader header{};
+    token_cache_detail::Layout layout{TokenCacheHeader{}};
+    const char *base = nullptr;
+
+    bool reject() {
+        file.reset();
+        base = nullptr;
+        return false;
+    }
+
+    template <typename T>
+    const T *section(size_t token_cache_detail::Layout::*start) const {
+        return reinterpret_cast<const T *>(base + layout.*start);
+    }
+
+    const char *strings() const {
+        return section<char>(&token_cache_detail::Layout::strings);
+    }
+};
+
+// Decodes an open cache's tokens in order. After next(), the fields describe
+// token `index`; line and column come from the line table.
+class TokenCacheReader {
+public:
+    uint32_t index = 0;
+    uint8_t kind = 0;
+    uint32_t symbol = TokenCacheData::NO_NAME;
+    uint32_t offset = 0, length = 0;
+    int32_t line = 0;
+    int32_t column = 0;
+
+    explicit TokenCacheReader(const TokenCacheFile &cache)
+        : kinds(cache.kinds()), tokens(cache.tokens()), lines(cache.lines()), numbers(cache.numbers()),
+          count(cache.info().tokenCount), linesLeft(cache.info().lineCount) {
+        readLine();
+    }
+
+    // Moves to the next token. Returns false, and changes nothing, once the
+    // last one has been read.
+    bool next() {
+        using namespace token_cache_detail;
+
+        if (read == count) return false;
+        index = read++;
+        kind = *tokens++;
+        const TokenCacheKind &format = kinds[kind];
+        offset = (uint32_t)(end + unzigzag(getVarint(tokens)));
+        length = format.length ? format.length : (uint32_t)getVarint(tokens);
+        symbol = format.named ? (uint32_t)getVarint(tokens) - 1 : TokenCacheData::NO_NAME;
+        end = (uint64_t)offset + length;
+        if (pending && upcoming.firstToken == index) {
+            current = upcoming;
+            readLine();
+        }
+        line = current.line;
+        column = (int32_t)(offset + length - current.bias);
+        return true;
+    }
+
+    // The value of the next numeric or character literal.
+    uint64_t number() {
+        return token_cache_detail::getVarint(numbers);
+    }
+
+private:
+    const TokenCacheKind *kinds;
+    const uint8_t *tokens, *lines, *numbers;
+    uint32_t count, read = 0;
+    uint64_t end = 0;  // Of the previous token
+    uint32_t linesLeft;
+    bool pending = false;  // `upcoming` holds an entry not yet reached
+    TokenCacheLine current{}, upcoming{};
+
+    void readLine() {
+        using namespace token_cache_detail;
+
+        pending = linesLeft > 0;
+        if (!pending) return;
+        --linesLeft;
+        upcoming.firstToken += (uint32_t)getVarint(lines);
+        upcoming.line += (int32_t)unzigzag(getVarint(lines));
+        upcoming.bias += (uint32_t)unzigzag(getVarint(lines));
+    }
+};
+
+#endif
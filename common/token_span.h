@@ -0,0 +1,47 @@
+#ifndef COMMON_TOKEN_SPAN_H
+#define COMMON_TOKEN_SPAN_H
+
+// Read-only, non-owning view of a token vector, for parsers that index
+// tokens rather than pulling them (see token_stream.h for those that pull).
+// Copying a span copies two words, and tokens are read by reference, so no
+// token or its string is ever copied:
+//
+//     vector<Token> tokens = lexer.tokenize();
+//     Parser parser(tokens);  // Parser holds a TokenSpan<Token>
+//     ...
+//     if (tokens[pos].type == T_ID) ...
+//
+// The vector must outlive the span; binding a span to a temporary vector
+// does not compile.
+
+#include <cstddef>
+#include <vector>
+
+template <typename Token>
+class TokenSpan {
+public:
+    TokenSpan(const std::vector<Token> &tokens) : first(tokens.data()), count(tokens.size()) {}
+    TokenSpan(std::vector<Token> &&) = delete;
+
+    const Token &operator[](size_t i) const {
+        return first[i];
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    const Token *begin() const {
+        return first;
+    }
+
+    const Token *end() const {
+        return first + count;
+    }
+
+private:
+    const Token *first;
+    size_t count;
+};
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef COMMON_TOKEN_STREAM_H
+#define COMMON_TOKEN_STREAM_H
+
+// Pull-based token stream with bounded lookahead.
+//
+// Wraps any lexer that has a `Token nextToken()` method returning its
+// end-of-file token once the input is exhausted (and on every call after).
+// Tokens are pulled on demand into a small ring buffer, so a parser holds at
+// most `Capacity` tokens no matter how large the input is:
+//
+//     Lexer lexer(source);
+//     TokenStream<Lexer> tokens(lexer);
+//     if (tokens.peek().type == T_ID && tokens.peek(1).type == T_ASSIGN) ...
+//     Token t = tokens.nextToken();
+//
+// References returned by peek() are only valid until the next call that
+// pulls from the lexer.
+
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+template <typename Source, size_t Capacity = 4>
+class TokenStream {
+public:
+    using Token = decltype(std::declval<Source &>().nextToken());
+
+    static_assert(Capacity && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    explicit TokenStream(Source &source) : source(source) {}
+
+    // Returns the token `k` places ahead without consuming it; k < Capacity,
+    // as a further token would overwrite one not yet consumed.
+    const Token &peek(size_t k = 0) {
+        assert(k < Capacity);
+        while (count <= k) {
+            ring[(head + count) & MASK] = source.nextToken();
+            count++;
+        }
+        return ring[(head + k) & MASK];
+    }
+
+    Token nextToken() {
+        peek();
+        Token token = std::move(ring[head]);
+        head = (head + 1) & MASK;
+        count--;
+        return token;
+    }
+
+private:
+    static const size_t MASK = Capacity - 1;
+
+    Source &source;
+    Token ring[Capacity];
+    size_t head = 0;
+    size_t count = 0;
+};
+
+#endif
@@ -5,6 +5,7 @@
 #include<string>
 #include<cctype>
 #include<map>
+#include"../common/keyword_table.h"
 
 using namespace std;
 
@@ -64,16 +65,10 @@ class lexer{
             else if (isalpha(current))
             {
                 string word = consumeWord();
-                if (word == "int")
-                    tokens.push_back(Token{TokenType::T_INT, word});
-                else if (word == "if")
-                    tokens.push_back(Token{TokenType::T_IF, word});
-                else if (word == "else")
-                    tokens.push_back(Token{TokenType::T_ELSE, word});
-                else if (word == "return")
-                    tokens.push_back(Token{TokenType::T_RETURN, word});
-                else
-                    tokens.push_back(Token{TokenType::T_ID, word});
+                static constexpr auto keywords = makeKeywordTable<TokenType>({
+                    {"int", T_INT}, {"if", T_IF}, {"else", T_ELSE}, {"return", T_RETURN}
+                });
+                tokens.push_back(Token{keywords.find(word, T_ID), word});
                 continue;
             }
 
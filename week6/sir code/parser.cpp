@@ -3,6 +3,9 @@
 #include <string>
 #include <cctype>
 #include <map>
+#include <stdexcept>
+#include "../../common/keyword_table.h"
+#include "../../common/token_span.h"
 
 using namespace std;
 
@@ -52,11 +55,10 @@ class Lexer {
                 }
                 if (isalpha(current)) {
                     string word = consumeWord();
-                    if (word == "int") tokens.push_back(Token{T_INT, word});
-                    else if (word == "if") tokens.push_back(Token{T_IF, word});
-                    else if (word == "else") tokens.push_back(Token{T_ELSE, word});
-                    else if (word == "return") tokens.push_back(Token{T_RETURN, word});
-                    else tokens.push_back(Token{T_ID, word});
+                    static constexpr auto keywords = makeKeywordTable<TokenType>({
+                        {"int", T_INT}, {"if", T_IF}, {"else", T_ELSE}, {"return", T_RETURN}
+                    });
+                    tokens.push_back(Token{keywords.find(word, T_ID), word});
                     continue;
                 }
                 
@@ -99,23 +101,65 @@ class Parser {
  
 
 public:
-    Parser(const vector<Token> &tokens) {
-        this->tokens = tokens;  
-        this->pos = 0;          
-    }
+    Parser(TokenSpan<Token> tokens) : tokens(tokens), pos(0) {}
 
+    // A statement with an error is reported and skipped (see synchronize), so
+    // one run reports every error in the program.
     void parseProgram() {
         while (tokens[pos].type != T_EOF) {
             parseStatement();
         }
-        cout << "Parsing completed successfully! No Syntax Error" << endl;
+        if (errors == 0) {
+            cout << "Parsing completed successfully! No Syntax Error" << endl;
+        } else {
+            cout << "Parsing completed with " << errors << " Syntax Error" << (errors == 1 ? "" : "s") << endl;
+        }
+    }
+
+    int errorCount() const {
+        return errors;
     }
 
 private:
-    vector<Token> tokens;
+    TokenSpan<Token> tokens;  // The caller's vector, not a copy
     size_t pos;
+    int errors = 0;
+    int depth = 0;  // Blocks open around the current statement
 
+    // Errors are thrown out of whatever the statement was in the middle of.
     void parseStatement() {
+        try {
+            parseStatementOrThrow();
+        } catch (const runtime_error &e) {
+            cout << e.what() << endl;
+            errors++;
+            synchronize();
+        }
+    }
+
+    // Panic mode: skips the rest of the broken statement, up to and including
+    // its ';', or up to the '}' closing the enclosing block or a token that
+    // can only start a statement. A '}' with no block open is skipped too, so
+    // every error moves the parser forward.
+    void synchronize() {
+        for (;;) {
+            switch (tokens[pos].type) {
+                case T_EOF: case T_INT: case T_IF: case T_RETURN: case T_LBRACE:
+                    return;
+                case T_SEMICOLON:
+                    pos++;
+                    return;
+                case T_RBRACE:
+                    if (depth > 0) return;
+                    pos++;
+                    break;
+                default:
+                    pos++;
+            }
+        }
+    }
+
+    void parseStatementOrThrow() {
         if (tokens[pos].type == T_INT) {
             parseDeclaration();
         } else if (tokens[pos].type == T_ID) {
@@ -127,16 +171,17 @@ private:
         } else if (tokens[pos].type == T_LBRACE) {  
             parseBlock();
         } else {
-            cout << "Syntax error: unexpected token " << tokens[pos].value << endl;
-            exit(1);
+            throw runtime_error("Syntax error: unexpected token " + tokens[pos].value);
         }
     }
 
     void parseBlock() {
         expect(T_LBRACE);  
+        depth++;
         while (tokens[pos].type != T_RBRACE && tokens[pos].type != T_EOF) {
             parseStatement();
         }
+        depth--;
         expect(T_RBRACE);  
     }
     void parseDeclaration() {
@@ -198,8 +243,7 @@ private:
             parseExpression();
             expect(T_RPAREN);
         } else {
-            cout << "Syntax error: unexpected token " << tokens[pos].value << endl;
-            exit(1);
+            throw runtime_error("Syntax error: unexpected token " + tokens[pos].value);
         }
     }
 
@@ -207,8 +251,7 @@ private:
         if (tokens[pos].type == type) {
             pos++;
         } else {
-            cout << "Syntax error: expected " << type << " but found " << tokens[pos].value << endl;
-            exit(1);
+            throw runtime_error("Syntax error: expected " + to_string(type) + " but found " + tokens[pos].value);
         }
     }
 };
@@ -232,5 +275,5 @@ int main() {
     Parser parser(tokens);
     parser.parseProgram();
 
-    return 0;
+    return parser.errorCount() ? 1 : 0;
 }
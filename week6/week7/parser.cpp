@@ -4,6 +4,8 @@
 #include <fstream>
 #include <iostream>
 #include <cctype>
+#include "../../common/keyword_table.h"
+#include "../../common/token_span.h"
 using namespace std;
 
 enum TokenType
@@ -148,18 +150,10 @@ public:
             else if (isalpha(current))
             {
                 string word = consumeWord();
-                if (word == "int")
-                    tokens.push_back(Token{TokenType::T_INT, word});
-                else if (word == "float")
-                    tokens.push_back(Token{TokenType::T_FLOAT,word});
-                else if (word == "if")
-                    tokens.push_back(Token{TokenType::T_IF, word});
-                else if (word == "else")
-                    tokens.push_back(Token{TokenType::T_ELSE, word});
-                else if (word == "return")
-                    tokens.push_back(Token{TokenType::T_RETURN, word});
-                else
-                    tokens.push_back(Token{TokenType::T_ID, word});
+                static constexpr auto keywords = makeKeywordTable<TokenType>({
+                    {"int", T_INT}, {"float", T_FLOAT}, {"if", T_IF}, {"else", T_ELSE}, {"return", T_RETURN}
+                });
+                tokens.push_back(Token{keywords.find(word, T_ID), word});
                 continue;
             }
 
@@ -233,15 +227,11 @@ public:
 class Parser
 {
 private:
-    vector<Token> tokens;
+    TokenSpan<Token> tokens;  // The caller's vector, not a copy
     size_t pos;
 
 public:
-    Parser(vector<Token> &tokens)
-    {
-        this->tokens = tokens;
-        this->pos = 0;
-    }
+    Parser(TokenSpan<Token> tokens) : tokens(tokens), pos(0) {}
     void parseStatement()
     {
         if (tokens[pos].type == T_INT)